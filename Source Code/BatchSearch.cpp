@@ -0,0 +1,275 @@
+//Leo Croft
+
+// BatchSearch.cpp
+// ===============
+//
+// Implementation of the batch query executor
+//
+
+#include "BatchSearch.h" // Declaration of this class
+#include "MapLoader.h" // Coordinate and record formats
+#include <unordered_map>
+
+//numThreads of 0 uses one thread per hardware thread.
+CBatchSearch::CBatchSearch(ESearchType searchType, int numThreads, const CLandmarks* landmarks, const SMovementRules& movement, int clusterSize) :
+	mSearchType(searchType), mMovement(movement), mPool(numThreads)
+{
+	for (int i = 0; i < mPool.GetNumThreads(); i++)
+	{
+		mSearches.push_back(unique_ptr<ISearch>(NewSearch(searchType, landmarks, movement, clusterSize)));
+	}
+	mFields.resize(mPool.GetNumThreads());
+}
+
+//True if queries sharing a start can be answered from a distance field. The field is Dijkstra's algorithm with four way movement.
+//With a cache every query goes through it instead, so the cache sees them all.
+bool CBatchSearch::UsesFields() const
+{
+	return mSearchType == ESearchType::Dijkstra && mMovement.mMovement == EMovement::FourWay && mpCache == nullptr;
+}
+
+//Answers one query from the worker's distance field, building it from the query's start if needed.
+bool CBatchSearch::FindPathFromField(int worker, const TerrainMap& terrain, const SPathQuery& query, NodeList& path)
+{
+	if (!terrain.InBounds(query.mStart.x, query.mStart.y) || !terrain.InBounds(query.mGoal.x, query.mGoal.y))
+	{
+		return false;
+	}
+
+	CDistanceField& field = mFields[worker];
+	SIntVector source = field.GetSource();
+	if (!field.IsBuilt() || !field.Matches(terrain) || source.x != query.mStart.x || source.y != query.mStart.y)
+	{
+		if (!field.Build(terrain, query.mStart))
+		{
+			return false;
+		}
+	}
+	return field.PathTo(query.mGoal.x, query.mGoal.y, path);
+}
+
+//Answers one query on the given worker, using the cache if there is one. The path is left empty if none is found.
+bool CBatchSearch::FindPath(int worker, const TerrainMap& terrain, const SPathQuery& query, NodeList& path)
+{
+	//The searches don't check the bounds, so queries off the map are answered here.
+	if (!terrain.InBounds(query.mStart.x, query.mStart.y) || !terrain.InBounds(query.mGoal.x, query.mGoal.y))
+	{
+		return false;
+	}
+
+	if (mpCache != nullptr)
+	{
+		return mpCache->FindPath(*mSearches[worker], mSearchType, terrain, query.mStart, query.mGoal, path, mMovement);
+	}
+
+	unique_ptr<SNode> start(new SNode{ query.mStart.x, query.mStart.y, 0 });
+	unique_ptr<SNode> goal(new SNode{ query.mGoal.x, query.mGoal.y, 0 });
+	if (!mSearches[worker]->FindPath(terrain, move(start), move(goal), path))
+	{
+		path.clear(); //Some searches leave bookkeeping nodes in the path when they fail.
+		return false;
+	}
+	return true;
+}
+
+//Answers every query, blocking until they are all done. The results are in the same order as the queries.
+void CBatchSearch::FindPaths(const TerrainMap& terrain, const vector<SPathQuery>& queries, vector<SPathResult>& results)
+{
+	results.clear();
+	results.resize(queries.size());
+
+	//Each task is a list of query indexes. Queries sharing a start with enough others are grouped into tasks answered from a field;
+	//The rest are split into tasks of BATCH_QUERIES_PER_TASK in order.
+	vector<vector<int>> tasks;
+	vector<bool> taskUsesField;
+	unordered_map<int, vector<int>> queriesByStart;
+	if (UsesFields())
+	{
+		for (int i = 0; i < int(queries.size()); i++)
+		{
+			if (terrain.InBounds(queries[i].mStart.x, queries[i].mStart.y))
+			{
+				queriesByStart[terrain.Index(queries[i].mStart.x, queries[i].mStart.y)].push_back(i);
+			}
+		}
+		for (auto group = queriesByStart.begin(); group != queriesByStart.end(); group++)
+		{
+			const vector<int>& indexes = group->second;
+			if (int(indexes.size()) < BATCH_MIN_QUERIES_PER_FIELD)
+			{
+				continue;
+			}
+			for (int first = 0; first < int(indexes.size()); first += BATCH_MAX_QUERIES_PER_FIELD)
+			{
+				int last = min<int>(first + BATCH_MAX_QUERIES_PER_FIELD, indexes.size());
+				tasks.push_back(vector<int>(indexes.begin() + first, indexes.begin() + last));
+				taskUsesField.push_back(true);
+			}
+		}
+	}
+	for (int i = 0; i < int(queries.size()); i++)
+	{
+		if (!queriesByStart.empty() && terrain.InBounds(queries[i].mStart.x, queries[i].mStart.y) &&
+			int(queriesByStart[terrain.Index(queries[i].mStart.x, queries[i].mStart.y)].size()) >= BATCH_MIN_QUERIES_PER_FIELD)
+		{
+			continue; //Already in a field task.
+		}
+		if (tasks.empty() || taskUsesField.back() || int(tasks.back().size()) == BATCH_QUERIES_PER_TASK)
+		{
+			tasks.push_back(vector<int>());
+			taskUsesField.push_back(false);
+		}
+		tasks.back().push_back(i);
+	}
+
+	int numTasks = tasks.size();
+	if (numTasks == 0)
+	{
+		return;
+	}
+
+	//Each task writes only to its own results, so the only thing shared between tasks is the count of those still running.
+	mutex doneLock;
+	condition_variable done;
+	int remaining = numTasks;
+
+	for (int task = 0; task < numTasks; task++)
+	{
+		mPool.Submit([&, task](int worker)
+		{
+			for (auto i = tasks[task].begin(); i != tasks[task].end(); i++)
+			{
+				if (taskUsesField[task])
+				{
+					results[*i].mFound = FindPathFromField(worker, terrain, queries[*i], results[*i].mPath);
+				}
+				else
+				{
+					results[*i].mFound = FindPath(worker, terrain, queries[*i], results[*i].mPath);
+				}
+			}
+
+			lock_guard<mutex> lock(doneLock);
+			remaining--;
+			if (remaining == 0)
+			{
+				done.notify_one();
+			}
+		});
+	}
+
+	unique_lock<mutex> lock(doneLock);
+	done.wait(lock, [&remaining] { return remaining == 0; });
+}
+
+//Reads queries from a coordinate stream and answers them, writing one record per query in the order they finish.
+bool CBatchSearch::StreamPaths(const TerrainMap& terrain, istream& input, ostream& output, SStreamSummary& summary)
+{
+	summary = SStreamSummary();
+	const int maxTasks = GetNumThreads() * STREAM_TASKS_PER_THREAD;
+
+	//Shared with the workers. Each task adds its records as one block, so the workers touch the lock once per task.
+	mutex finishedLock;
+	condition_variable changed;
+	deque<string> finished;
+	int running = 0;
+	atomic<long long> found(0);
+
+	bool moreQueries = true;
+	while (true)
+	{
+		//Read and submit tasks until the limit of tasks in flight is reached, or the queries run out.
+		while (moreQueries)
+		{
+			{
+				lock_guard<mutex> lock(finishedLock);
+				if (running >= maxTasks)
+				{
+					break;
+				}
+			}
+
+			vector<SPathQuery> queries;
+			SPathQuery query;
+			while (queries.size() < BATCH_QUERIES_PER_TASK && ReadQuery(input, query.mStart, query.mGoal))
+			{
+				queries.push_back(query);
+			}
+			if (queries.size() < BATCH_QUERIES_PER_TASK)
+			{
+				moreQueries = false;
+			}
+			if (queries.empty())
+			{
+				break;
+			}
+
+			long long firstId = summary.mQueries;
+			summary.mQueries += queries.size();
+			{
+				lock_guard<mutex> lock(finishedLock);
+				running++;
+			}
+
+			mPool.Submit([&, firstId, queries](int worker)
+			{
+				string records;
+				for (int i = 0; i < int(queries.size()); i++)
+				{
+					//The stream is only read a task at a time, so fields are used for starts repeated within the task,
+					//or for the start the worker's field was last built from (the queries may be sorted by start).
+					bool useField = false;
+					if (UsesFields())
+					{
+						SIntVector source = mFields[worker].GetSource();
+						int sharing = 0;
+						for (int j = 0; j < int(queries.size()); j++)
+						{
+							if (queries[j].mStart.x == queries[i].mStart.x && queries[j].mStart.y == queries[i].mStart.y)
+							{
+								sharing++;
+							}
+						}
+						useField = sharing >= BATCH_MIN_QUERIES_PER_FIELD ||
+							(mFields[worker].Matches(terrain) && source.x == queries[i].mStart.x && source.y == queries[i].mStart.y);
+					}
+
+					NodeList path;
+					if ((useField) ? FindPathFromField(worker, terrain, queries[i], path) : FindPath(worker, terrain, queries[i], path))
+					{
+						found++;
+						AppendPathRecord(records, firstId + i, CalculatePathCost(terrain, path, mMovement), path);
+					}
+					else
+					{
+						AppendPathRecord(records, firstId + i, -1, path);
+					}
+				}
+
+				lock_guard<mutex> lock(finishedLock);
+				finished.push_back(move(records));
+				running--;
+				changed.notify_one();
+			});
+		}
+
+		//Write out whatever has finished. The lock is only held to take the records, not while writing them.
+		deque<string> toWrite;
+		{
+			unique_lock<mutex> lock(finishedLock);
+			if (!moreQueries && running == 0 && finished.empty())
+			{
+				break;
+			}
+			changed.wait(lock, [&finished] { return !finished.empty(); });
+			toWrite.swap(finished);
+		}
+		for (auto it = toWrite.begin(); it != toWrite.end(); it++)
+		{
+			output.write((*it).data(), (*it).size());
+		}
+	}
+
+	summary.mFound = found;
+	return input.eof();
+}
@@ -0,0 +1,111 @@
+//Leo Croft
+
+// BatchSearch.h
+// =============
+//
+// Answers a batch of start/goal queries on one map, spread over a thread pool
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "SearchFactory.h" // Search classes
+#include "ThreadPool.h" // Worker threads
+#include "PathCache.h" // Optional cache of answers
+#include "DistanceField.h" // Answers for queries sharing a start
+#include <istream>
+#include <ostream>
+
+//The number of queries given to a worker at a time. Large enough that queueing costs little next to the searches,
+//small enough that a few long searches don't leave the other workers idle.
+const int BATCH_QUERIES_PER_TASK = 16;
+
+//With Dijkstra, queries that share a start with at least this many others are answered from a distance field built from the start,
+//so many agents pathing from one spawn cost one search over the map between them, rather than one search each.
+const int BATCH_MIN_QUERIES_PER_FIELD = 4;
+
+//The most queries answered from one field in one task. A larger group is split so several workers can share it; Each builds its own field.
+const int BATCH_MAX_QUERIES_PER_FIELD = 1024;
+
+//When streaming, the number of tasks read ahead for each worker. Bounds the memory used however many queries the stream holds.
+const int STREAM_TASKS_PER_THREAD = 4;
+
+//One query for a batch.
+struct SPathQuery
+{
+	SIntVector mStart;
+	SIntVector mGoal;
+};
+
+//The answer to one query. The path is empty if none was found.
+struct SPathResult
+{
+	bool mFound = false;
+	NodeList mPath;
+
+	//The path owns its nodes, so results can only be moved.
+	SPathResult() = default;
+	SPathResult(SPathResult&&) = default;
+	SPathResult& operator=(SPathResult&&) = default;
+	SPathResult(const SPathResult&) = delete;
+	SPathResult& operator=(const SPathResult&) = delete;
+};
+
+//Totals for a stream of queries.
+struct SStreamSummary
+{
+	long long mQueries = 0;
+	long long mFound = 0;
+};
+
+// Each worker of the pool has its own search object, so the scratch state kept by the searches is never shared between threads.
+// The terrain is only read, so every worker searches the same map.
+// With Dijkstra, four way movement and no cache, queries that share a start are answered from a distance field (see CDistanceField):
+// FindPaths groups the batch by start, and StreamPaths uses a field for starts repeated within a task, or matching the worker's last field.
+// The paths cost the same as Dijkstra's, but where there are several cheapest paths they may take a different one.
+// A CBatchSearch runs one batch at a time; Use one per thread if batches are needed from several threads at once.
+class CBatchSearch
+{
+private:
+	ESearchType mSearchType;
+	SMovementRules mMovement; //Used by the searches, and to work out the cost of the paths written by StreamPaths.
+	CThreadPool mPool;
+	vector<unique_ptr<ISearch>> mSearches; //One for each worker.
+	vector<CDistanceField> mFields; //One for each worker, for queries that share a start.
+	CPathCache* mpCache = nullptr; //Not owned. May be shared with other batches and other threads.
+
+	//Answers one query on the given worker, using the cache if there is one. The path is left empty if none is found.
+	bool FindPath(int worker, const TerrainMap& terrain, const SPathQuery& query, NodeList& path);
+
+	//True if queries sharing a start can be answered from a distance field, which finds the same costs as the search.
+	bool UsesFields() const;
+
+	//Answers one query from the worker's distance field, first building the field from the query's start unless it already was,
+	//for this version of the map.
+	bool FindPathFromField(int worker, const TerrainMap& terrain, const SPathQuery& query, NodeList& path);
+
+public:
+	//numThreads of 0 uses one thread per hardware thread. The landmarks are shared by every worker's search; See NewSearch.
+	CBatchSearch(ESearchType searchType, int numThreads = 0, const CLandmarks* landmarks = nullptr, const SMovementRules& movement = SMovementRules(),
+		int clusterSize = 0);
+
+	//Answers every query, blocking until they are all done. The results are in the same order as the queries.
+	void FindPaths(const TerrainMap& terrain, const vector<SPathQuery>& queries, vector<SPathResult>& results);
+
+	//Reads queries from a coordinate stream (see ReadQuery) and answers them, writing one record per query (see AppendPathRecord)
+	//in the order they finish. Only a few tasks per worker are read ahead, so memory stays bounded for streams of any length.
+	//Returns false if the stream holds a query that can't be read; The queries before it are still answered.
+	bool StreamPaths(const TerrainMap& terrain, istream& input, ostream& output, SStreamSummary& summary);
+
+	//Answers queries through the cache, or searches every query if the cache is null.
+	//The cache tells paths apart by search type and movement rules, so one can be shared between any batches.
+	void SetPathCache(CPathCache* cache)
+	{
+		mpCache = cache;
+	}
+
+	int GetNumThreads() const
+	{
+		return mPool.GetNumThreads();
+	}
+};
@@ -0,0 +1,355 @@
+//Leo Croft
+
+// Benchmark.cpp
+// =============
+//
+// Standalone program (no TL-Engine) that runs every search over generated maps of increasing size and prints the results as CSV or JSON.
+// Gives a baseline to compare each change to the searches against.
+//
+// Usage: Benchmark [options]
+//   --sizes 10,64,256     Map sizes to generate (square). Defaults to 10,32,128,512,1024,2048,4096
+//   --styles Open,Maze    Map styles from MAP_STYLE_NAMES. Defaults to all of them
+//   --searches AStar      Searches from SEARCH_TYPE_NAMES. Defaults to all of them. AStarSorted adds A* with the open list sorted before
+//                         every pop, as it was before the binary heap, to measure the open lists against. It is slow on large maps, so it is
+//                         never included by default, and it only moves in four directions
+//   --repeats 3           The number of times each search is run on each map. The fastest run is reported
+//   --seed 12345          Seed for the map generator
+//   --format csv|json     Defaults to csv
+//   --landmarks 8         Give the A* searches the ALT heuristic with this many landmarks. Building the tables isn't included in the times
+//   --movement four|eight|eight-cut  Move in four directions (the default), or eight with or without cutting corners. Eight way costs are in tenths
+//   --cluster-sizes 8,16  HPAStar is run once for each of these cluster widths. Defaults to HPA_DEFAULT_CLUSTER_SIZE
+//
+
+#include "SearchFactory.h" // Search classes
+#include "SearchAStar.h" // The sorted open list baseline
+#include "SearchHPAStar.h" // Default cluster size
+#include "MapGenerator.h" // Generated maps
+#include "NodePool.h" // Allocation counters
+#include "Landmarks.h" // ALT heuristic
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+
+const unsigned int DEFAULT_BENCHMARK_SEED = 12345; //Fixed so that every run generates the same maps.
+const int DEFAULT_BENCHMARK_REPEATS = 3;
+const string SORTED_BASELINE_NAME = "AStarSorted"; //See CSortedOpenList.
+
+//Names for --movement, and the movement column of the output.
+const string MOVEMENT_FOUR_WAY = "four";
+const string MOVEMENT_EIGHT_WAY = "eight";
+const string MOVEMENT_EIGHT_WAY_CUT_CORNERS = "eight-cut";
+
+//The results of running one search on one map.
+struct SBenchmarkResult
+{
+	string mSearch;
+	string mStyle;
+	int mWidth;
+	int mHeight;
+	bool mFound;
+	int mPathLength;
+	int mPathCost;
+	long long mNodesExpanded; //From the search's statistics. See SSearchStats.
+	long long mNodesGenerated;
+	double mMilliseconds; //Wall time of the fastest run.
+	long long mPeakNodeBytes; //The most memory held in nodes at once during the search.
+	long long mPeakScratchBytes; //The memory held by the search's own arrays besides nodes. See SSearchStats.
+	long long mHeapAllocations; //Heap allocations made by the node pool during the last run. Zero once the pool has warmed up.
+	long long mReopenings; //From the search's statistics.
+	long long mPeakOpenSize;
+	long long mPeakClosedSize;
+	double mEpsilon; //The bound on the path cost the search reported. See SSearchStats.
+	string mMovement;
+	int mClusterSize; //HPA*'s cluster width. 0 for the other searches.
+};
+
+//Splits a comma separated list.
+vector<string> SplitList(const string& list)
+{
+	vector<string> items;
+	stringstream stream(list);
+	string item;
+	while (getline(stream, item, ','))
+	{
+		if (!item.empty())
+		{
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+//Runs the search on the map the given number of times, keeping the fastest time.
+SBenchmarkResult RunBenchmark(ISearch& search, const string& searchName, EMapStyle style, const TerrainMap& terrain, SIntVector startCoords,
+	SIntVector goalCoords, int repeats, const SMovementRules& movement)
+{
+	SBenchmarkResult result = {};
+	result.mSearch = searchName;
+	result.mStyle = MAP_STYLE_NAMES[style];
+	result.mWidth = terrain.GetWidth();
+	result.mHeight = terrain.GetHeight();
+
+	result.mMovement = (movement.mMovement == EMovement::FourWay) ? MOVEMENT_FOUR_WAY : (movement.mCutCorners) ? MOVEMENT_EIGHT_WAY_CUT_CORNERS : MOVEMENT_EIGHT_WAY;
+
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		NodeList path;
+		unique_ptr<SNode> start(new SNode{ startCoords.x, startCoords.y, 0 });
+		unique_ptr<SNode> goal(new SNode{ goalCoords.x, goalCoords.y, 0 });
+
+		CNodePool::ResetPeak();
+		SNodePoolCounters before = CNodePool::GetCounters();
+
+		auto startTime = chrono::steady_clock::now();
+		bool found = search.FindPath(terrain, move(start), move(goal), path);
+		double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+
+		SNodePoolCounters after = CNodePool::GetCounters();
+
+		if (repeat == 0 || milliseconds < result.mMilliseconds)
+		{
+			result.mMilliseconds = milliseconds;
+		}
+
+		result.mFound = found;
+		result.mPathLength = path.size();
+		result.mPathCost = (found) ? CalculatePathCost(terrain, path, movement) : 0;
+		result.mPeakNodeBytes = (after.mPeakLiveNodes - before.mLiveNodes) * sizeof(SNode);
+		result.mHeapAllocations = after.mHeapAllocations - before.mHeapAllocations;
+
+		const SSearchStats& stats = search.GetStats();
+		result.mNodesExpanded = stats.mNodesExpanded;
+		result.mNodesGenerated = stats.mNodesGenerated;
+		result.mReopenings = stats.mReopenings;
+		result.mPeakOpenSize = stats.mPeakOpenSize;
+		result.mPeakClosedSize = stats.mPeakClosedSize;
+		result.mEpsilon = stats.mEpsilon;
+		result.mPeakScratchBytes = stats.mScratchBytes;
+	}
+
+	return result;
+}
+
+//Nodes per second, or 0 if the count isn't known or the time was too short to measure.
+double PerSecond(long long nodes, double milliseconds)
+{
+	return (nodes >= 0 && milliseconds > 0.0) ? nodes / (milliseconds / 1000.0) : 0.0;
+}
+
+void PrintCSVHeader()
+{
+	cout << "search,style,width,height,found,path length,path cost,nodes expanded,nodes generated,milliseconds,"
+		 << "expanded per second,generated per second,peak node bytes,peak scratch bytes,node heap allocations,reopenings,peak open,peak closed,epsilon,movement,cluster size" << endl;
+}
+
+void PrintCSV(const SBenchmarkResult& result)
+{
+	cout << result.mSearch << "," << result.mStyle << "," << result.mWidth << "," << result.mHeight << "," << result.mFound << ","
+		 << result.mPathLength << "," << result.mPathCost << "," << result.mNodesExpanded << "," << result.mNodesGenerated << ","
+		 << result.mMilliseconds << "," << PerSecond(result.mNodesExpanded, result.mMilliseconds) << ","
+		 << PerSecond(result.mNodesGenerated, result.mMilliseconds) << "," << result.mPeakNodeBytes << "," << result.mPeakScratchBytes << ","
+		 << result.mHeapAllocations << ","
+		 << result.mReopenings << "," << result.mPeakOpenSize << "," << result.mPeakClosedSize << "," << result.mEpsilon << "," << result.mMovement << ","
+		 << result.mClusterSize << endl;
+}
+
+//Prints one element of the JSON array. Every element after the first starts with a comma.
+void PrintJSON(const SBenchmarkResult& result, bool first)
+{
+	cout << (first ? "  " : ", ") << "{ \"search\": \"" << result.mSearch << "\", \"style\": \"" << result.mStyle
+		 << "\", \"width\": " << result.mWidth << ", \"height\": " << result.mHeight << ", \"found\": " << (result.mFound ? "true" : "false")
+		 << ", \"pathLength\": " << result.mPathLength << ", \"pathCost\": " << result.mPathCost
+		 << ", \"nodesExpanded\": " << result.mNodesExpanded << ", \"nodesGenerated\": " << result.mNodesGenerated
+		 << ", \"milliseconds\": " << result.mMilliseconds << ", \"expandedPerSecond\": " << PerSecond(result.mNodesExpanded, result.mMilliseconds)
+		 << ", \"generatedPerSecond\": " << PerSecond(result.mNodesGenerated, result.mMilliseconds)
+		 << ", \"peakNodeBytes\": " << result.mPeakNodeBytes << ", \"peakScratchBytes\": " << result.mPeakScratchBytes
+		 << ", \"nodeHeapAllocations\": " << result.mHeapAllocations
+		 << ", \"reopenings\": " << result.mReopenings << ", \"peakOpen\": " << result.mPeakOpenSize << ", \"peakClosed\": " << result.mPeakClosedSize
+		 << ", \"epsilon\": " << result.mEpsilon << ", \"movement\": \"" << result.mMovement << "\", \"clusterSize\": " << result.mClusterSize
+		 << " }" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	vector<int> sizes = { 10, 32, 128, 512, 1024, 2048, 4096 };
+	vector<EMapStyle> styles;
+	vector<ESearchType> searches;
+	int repeats = DEFAULT_BENCHMARK_REPEATS;
+	unsigned int seed = DEFAULT_BENCHMARK_SEED;
+	bool json = false;
+	bool sortedBaseline = false;
+	int numLandmarks = 0;
+	SMovementRules movement;
+	vector<int> clusterSizes = { HPA_DEFAULT_CLUSTER_SIZE };
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		string option = argv[i];
+		string value = argv[i + 1];
+
+		if (option == "--sizes")
+		{
+			sizes.clear();
+			vector<string> items = SplitList(value);
+			for (auto it = items.begin(); it != items.end(); it++)
+			{
+				sizes.push_back(stoi(*it));
+			}
+		}
+		else if (option == "--styles")
+		{
+			vector<string> items = SplitList(value);
+			for (auto it = items.begin(); it != items.end(); it++)
+			{
+				for (int style = 0; style < EMapStyle::NumOfMapStyles; style++)
+				{
+					if (MAP_STYLE_NAMES[style] == *it)
+					{
+						styles.push_back(EMapStyle(style));
+					}
+				}
+			}
+		}
+		else if (option == "--searches")
+		{
+			vector<string> items = SplitList(value);
+			for (auto it = items.begin(); it != items.end(); it++)
+			{
+				ESearchType searchType;
+				if (SearchTypeFromName(*it, searchType))
+				{
+					searches.push_back(searchType);
+				}
+				else if (*it == SORTED_BASELINE_NAME)
+				{
+					sortedBaseline = true;
+				}
+			}
+		}
+		else if (option == "--repeats")
+		{
+			repeats = max(1, stoi(value));
+		}
+		else if (option == "--seed")
+		{
+			seed = stoul(value);
+		}
+		else if (option == "--format")
+		{
+			json = (value == "json");
+		}
+		else if (option == "--landmarks")
+		{
+			numLandmarks = max(0, stoi(value));
+		}
+		else if (option == "--movement")
+		{
+			if (value != MOVEMENT_FOUR_WAY && value != MOVEMENT_EIGHT_WAY && value != MOVEMENT_EIGHT_WAY_CUT_CORNERS)
+			{
+				cerr << "Unknown movement: " << value << endl;
+				return 1;
+			}
+			movement.mMovement = (value == MOVEMENT_FOUR_WAY) ? EMovement::FourWay : EMovement::EightWay;
+			movement.mCutCorners = (value == MOVEMENT_EIGHT_WAY_CUT_CORNERS);
+		}
+		else if (option == "--cluster-sizes")
+		{
+			clusterSizes.clear();
+			vector<string> items = SplitList(value);
+			for (auto it = items.begin(); it != items.end(); it++)
+			{
+				clusterSizes.push_back(max(1, stoi(*it)));
+			}
+		}
+		else
+		{
+			cerr << "Unknown option: " << option << endl;
+			return 1;
+		}
+	}
+
+	//Default to every style and every registered search.
+	if (styles.empty())
+	{
+		for (int style = 0; style < EMapStyle::NumOfMapStyles; style++)
+		{
+			styles.push_back(EMapStyle(style));
+		}
+	}
+	if (searches.empty() && !sortedBaseline)
+	{
+		for (int searchType = 0; searchType < ESearchType::NumOfSearches; searchType++)
+		{
+			searches.push_back(ESearchType(searchType));
+		}
+	}
+
+	if (json)
+	{
+		cout << "[" << endl;
+	}
+	else
+	{
+		PrintCSVHeader();
+	}
+
+	TerrainMap terrain;
+	SIntVector start;
+	SIntVector goal;
+	CLandmarks landmarks;
+	const CLandmarks* landmarkTables = (numLandmarks > 0) ? &landmarks : nullptr; //Without landmarks the A* searches use the plain kernel.
+	bool first = true;
+
+	for (auto size = sizes.begin(); size != sizes.end(); size++)
+	{
+		for (auto style = styles.begin(); style != styles.end(); style++)
+		{
+			GenerateMap(terrain, *size, *size, *style, seed, start, goal);
+			if (numLandmarks > 0)
+			{
+				landmarks.Build(terrain, numLandmarks);
+			}
+
+			vector<SBenchmarkResult> results;
+			for (auto searchType = searches.begin(); searchType != searches.end(); searchType++)
+			{
+				//HPA* is swept over the cluster sizes, unless it is replaced by A* because corners are cut.
+				bool clustered = (*searchType == ESearchType::HPAStar && !(movement.mMovement == EMovement::EightWay && movement.mCutCorners));
+				int numRuns = (clustered) ? clusterSizes.size() : 1;
+				for (int run = 0; run < numRuns; run++)
+				{
+					int clusterSize = (clustered) ? clusterSizes[run] : 0;
+					unique_ptr<ISearch> search(NewSearch(*searchType, landmarkTables, movement, clusterSize));
+					results.push_back(RunBenchmark(*search, SEARCH_TYPE_NAMES[*searchType], *style, terrain, start, goal, repeats, movement));
+					results.back().mClusterSize = clusterSize;
+				}
+			}
+			if (sortedBaseline && movement.mMovement == EMovement::FourWay)
+			{
+				CSearchAStarSorted search;
+				results.push_back(RunBenchmark(search, SORTED_BASELINE_NAME, *style, terrain, start, goal, repeats, movement));
+			}
+
+			for (auto result = results.begin(); result != results.end(); result++)
+			{
+				if (json)
+				{
+					PrintJSON(*result, first);
+				}
+				else
+				{
+					PrintCSV(*result);
+				}
+				first = false;
+			}
+		}
+	}
+
+	if (json)
+	{
+		cout << "]" << endl;
+	}
+
+	return 0;
+}
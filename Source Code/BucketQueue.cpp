@@ -0,0 +1,112 @@
+//Leo Croft
+
+// BucketQueue.cpp
+// ===============
+//
+// Implementation of the circular bucket queue
+//
+
+#include "BucketQueue.h" // Declaration of this class
+
+//Range is the largest expected difference between the lowest and highest score on the queue.
+CBucketQueue::CBucketQueue(int range)
+{
+	int size = 1;
+	while (size <= range)
+	{
+		size *= 2;
+	}
+	mBuckets.resize(size);
+	mMask = size - 1;
+}
+
+//Removes all nodes. The memory of the buckets is kept for the next search.
+void CBucketQueue::Clear()
+{
+	for (auto it = mBuckets.begin(); it != mBuckets.end(); it++)
+	{
+		(*it).clear();
+	}
+	mCount = 0;
+	mWindowPlaced = false;
+}
+
+//Nodes with a score below the front of the queue are placed in the front bucket.
+void CBucketQueue::Push(SNode* node)
+{
+	int score = node->mScore;
+
+	//The first node pushed after clearing decides where the window starts.
+	//After that the front only moves forward, as scores popped from an A* open list never decrease.
+	if (!mWindowPlaced)
+	{
+		mMinScore = score;
+		mWindowPlaced = true;
+	}
+	else if (score < mMinScore)
+	{
+		score = mMinScore;
+	}
+	else if (score - mMinScore > mMask)
+	{
+		Grow(score);
+	}
+
+	mBuckets[score & mMask].push_back(node);
+	mCount++;
+}
+
+//Returns a node with the lowest score, or nullptr if the queue is empty.
+SNode* CBucketQueue::Pop()
+{
+	if (mCount == 0)
+	{
+		return nullptr;
+	}
+
+	//Advance the front of the window to the first bucket with nodes in it. This is at most one lap of the buckets.
+	while (mBuckets[mMinScore & mMask].empty())
+	{
+		mMinScore++;
+	}
+
+	vector<SNode*>& bucket = mBuckets[mMinScore & mMask];
+	SNode* node = bucket.back(); //Last in, first out; This favours the most recently found (deepest) nodes when scores are tied.
+	bucket.pop_back();
+	mCount--;
+	return node;
+}
+
+//Doubles the number of buckets until the score fits in the window, and redistributes the nodes.
+void CBucketQueue::Grow(int score)
+{
+	int size = mBuckets.size();
+	while (score - mMinScore >= size)
+	{
+		size *= 2;
+	}
+
+	vector<vector<SNode*>> oldBuckets(size);
+	oldBuckets.swap(mBuckets);
+	int oldMask = mMask;
+	mMask = size - 1;
+
+	//Each old bucket holds nodes for exactly one score in the old window. Nodes clamped to the front keep the front score.
+	for (int offset = 0; offset <= oldMask; offset++)
+	{
+		int bucketScore = mMinScore + offset;
+		vector<SNode*>& oldBucket = oldBuckets[bucketScore & oldMask];
+		mBuckets[bucketScore & mMask].swap(oldBucket);
+	}
+}
+
+//The memory held by the buckets.
+long long CBucketQueue::Bytes() const
+{
+	long long bytes = mBuckets.capacity() * sizeof(vector<SNode*>);
+	for (auto it = mBuckets.begin(); it != mBuckets.end(); it++)
+	{
+		bytes += it->capacity() * sizeof(SNode*);
+	}
+	return bytes;
+}
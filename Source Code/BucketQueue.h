@@ -0,0 +1,51 @@
+//Leo Croft
+
+// BucketQueue.h
+// =============
+//
+// Circular bucket queue (Dial's algorithm) used as an open list.
+// Terrain costs are small integers and the heuristic changes by a bounded amount per move, so every score
+// on the open list lies within a narrow window above the lowest one. Each score in that window gets its own bucket,
+// giving amortised O(1) push and pop.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+
+class CBucketQueue
+{
+private:
+	vector<vector<SNode*>> mBuckets; //One bucket per score in the window. The size is always a power of 2 so it can be wrapped with a mask.
+	int mMask; //mBuckets.size() - 1
+	int mMinScore = 0; //The score of the bucket at the front of the queue.
+	bool mWindowPlaced = false; //False until the first node is pushed after clearing. That node decides where the window starts.
+	int mCount = 0; //The number of nodes in all of the buckets.
+
+	//Doubles the number of buckets until the score fits in the window, and redistributes the nodes.
+	//Only happens if a score is pushed that is further above the front than the range given to the constructor.
+	void Grow(int score);
+
+public:
+	//Range is the largest expected difference between the lowest and highest score on the queue.
+	CBucketQueue(int range);
+
+	//Removes all nodes. The memory of the buckets is kept for the next search.
+	void Clear();
+
+	//The queue does not own the nodes; They are still owned by the open list.
+	//Nodes with a score below the front of the queue are placed in the front bucket.
+	void Push(SNode* node);
+
+	//Returns a node with the lowest score, or nullptr if the queue is empty.
+	//Nodes that were pushed again after their score changed will be returned more than once; The caller should skip the extras.
+	SNode* Pop();
+
+	bool Empty()
+	{
+		return mCount == 0;
+	}
+
+	//The memory held by the buckets.
+	long long Bytes() const;
+};
@@ -19,7 +19,7 @@ CMapHandler::CMapHandler(I3DEngine* myEngine)
 //When setting the start and end nodes, change the texture of the current node before changing the texture of the new node.
 void CMapHandler::SetStartNode(const SIntVector &coords)
 {
-	mMapVisual[NodeIndex(mStartNode)].mpBody->SetSkin(NODE_SKINS[mMapData[mStartNode.x][mStartNode.y]]); // Set the texture of the old start node.
+	mMapVisual[NodeIndex(mStartNode)].mpBody->SetSkin(NODE_SKINS[mMapData.Get(mStartNode.x, mStartNode.y)]); // Set the texture of the old start node.
 
 	mStartNode.x = coords.x;
 	mStartNode.y = coords.y;
@@ -32,7 +32,7 @@ SIntVector CMapHandler::GetStartNode()
 }
 void CMapHandler::SetEndNode(const SIntVector &coords)
 {
-	mMapVisual[NodeIndex(mEndNode)].mpBody->SetSkin(NODE_SKINS[mMapData[mEndNode.x][mEndNode.y]]); // Set the texture of the old start node.
+	mMapVisual[NodeIndex(mEndNode)].mpBody->SetSkin(NODE_SKINS[mMapData.Get(mEndNode.x, mEndNode.y)]); // Set the texture of the old start node.
 
 	mEndNode.x = coords.x;
 	mEndNode.y = coords.y;
@@ -154,7 +154,7 @@ void CMapHandler::SetupTerrain()
 	{
 		for (int z = 0; z < mDimensions.y; z++)
 		{
-			mMapVisual[NodeIndex(x, z)].mpBody->SetSkin(NODE_SKINS[mMapData[x][z]]);
+			mMapVisual[NodeIndex(x, z)].mpBody->SetSkin(NODE_SKINS[mMapData.Get(x, z)]);
 		}
 	}
 
@@ -165,9 +165,9 @@ void CMapHandler::SetupTerrain()
 /** Path/Search demonstration manipulation **/
 //If there aren't enough models available to demonstrate the search, push more onto the end.
 //Loop through openlist and closedlist, place them just above the nodes in the list and apply the relevant textures.
-void CMapHandler::SetupSearchDemo()
+void CMapHandler::SetupSearchDemo(const NodeList& openList, const NodeList& closedList)
 {
-	int overlaysRequired = mOpenList.size() + mClosedList.size(); // The number of overlays required to display the search.
+	int overlaysRequired = openList.size() + closedList.size(); // The number of overlays required to display the search.
 	int oldSize = mSearchOverlay.size();
 	//If there are not enough overlays available, resize to make more.
 	if (mSearchOverlay.size() < overlaysRequired)
@@ -184,14 +184,14 @@ void CMapHandler::SetupSearchDemo()
 
 	//Check each element in each list and put an overlay on it's position.
 	//Set the texture of the overlay according to whether it represents a node on the closed list or open list.
-	for (auto it = mOpenList.begin(); it != mOpenList.end(); it++)
+	for (auto it = openList.begin(); it != openList.end(); it++)
 	{
 		position = GetNodePosition((*it)->x, (*it)->y);
 		mSearchOverlay[overlayCount]->SetPosition(position.x, position.y + OVERLAY_Y, position.z);
 		mSearchOverlay[overlayCount]->SetSkin(OPENLIST_TEXTURE);
 		overlayCount++;
 	}
-	for (auto it = mClosedList.begin(); it != mClosedList.end(); it++)
+	for (auto it = closedList.begin(); it != closedList.end(); it++)
 	{
 		position = GetNodePosition((*it)->x, (*it)->y);
 		mSearchOverlay[overlayCount]->SetPosition(position.x, position.y + OVERLAY_Y, position.z);
@@ -221,9 +221,8 @@ void CMapHandler::ReadMap()
 {
 	string userInput;
 	string mapFile;
-	ifstream mapReader;
 	string coordFile;
-	ifstream coordReader;
+	TerrainMap newMapData; //The map is read into here, and only replaces the current map once both files have been read.
 
 	//Get the user's input
 	cout << MAP_CMD_PROMPT;
@@ -238,47 +237,19 @@ void CMapHandler::ReadMap()
 		mapFile = userInput + string(MAP_FILE_EXTENSION);
 		coordFile = userInput + string(COORD_FILE_EXTENSION);
 
-		//Attempt to open the map file. If successful, attempt to open the Coord file.
-		//If both are successful, process the data in the files.
-		mapReader.open(mapFile);
-		if (mapReader) //If the map file was opened successfully
+		//Attempt to read the map file. If successful, attempt to read the Coord file.
+		//The parsing is shared with the command line tools; See MapLoader.h
+		if (LoadMapFile(mapFile, newMapData)) //If the map file was read successfully
 		{
 			cout << MAP_FILE_SUCCESS << mapFile << endl;
 
-			coordReader.open(coordFile);
-			if (coordReader) //If the coordinates file was opened successfully
+			//Read the Coord File. This gives the Start and End positions.
+			if (LoadCoordFile(coordFile, mStartNode, mEndNode)) //If the coordinates file was read successfully
 			{
 				cout << COORD_FILE_SUCCESS << coordFile << endl;
 
-				//Read the map file
-				mapReader >> mDimensions.x >> mDimensions.y; //Getting the dimensions from the first line
-
-				mMapData.resize(mDimensions.x); //Resize the data vector to fit every column.
-
-				for (int x = 0; x < mDimensions.x; x++)
-				{
-					mMapData[x].resize(mDimensions.y); //Resize each of the columns to match the number of rows.
-				}
-
-				for (int z = mDimensions.y - 1; z >= 0; z--)
-				{
-					//Read each of the individual spaces from the file as characters, then convert it into an integer and then into the node type.
-					for (int x = 0; x < mDimensions.x; x++)
-					{
-						char nodeScore;
-						mapReader >> nodeScore;
-
-						//Before being parsed into the type, the character has the ascii character for 0 removed to translate it into an int.
-						mMapData[x][z] = ENodeType(nodeScore - '0');
-					}
-				}
-				mapReader.close();
-
-				//Read the Coord File. This gives the Start and End positions.
-				coordReader >> mStartNode.x >> mStartNode.y;
-				coordReader >> mEndNode.x >> mEndNode.y;
-
-				coordReader.close();
+				mMapData = move(newMapData);
+				mDimensions = { mMapData.GetWidth(), mMapData.GetHeight() };
 
 				//Setup the visual representation of the grid, then set the skins.
 				SetupGrid();
@@ -301,13 +272,5 @@ void CMapHandler::ReadMap()
 //Take the path generated by the search and output it to a file.
 void CMapHandler::SaveResultsToFile(NodeList &path)
 {
-	ofstream outFile(PATH_OUTPUT_FILE);
-	if (outFile)
-	{
-		for (NodeList::iterator it = path.begin(); it != path.end(); it++)
-		{
-			outFile << (*it)->x << ", " << (*it)->y << endl;
-		}
-		outFile.close();
-	}
+	SavePathFile(PATH_OUTPUT_FILE, path);
 }
\ No newline at end of file
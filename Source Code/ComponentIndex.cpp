@@ -0,0 +1,268 @@
+//Leo Croft
+
+// ComponentIndex.cpp
+// ==================
+//
+// Implementation of the connected area labels
+//
+
+#include "ComponentIndex.h" // Declaration of this class
+#include "TerrainMap.h" // The map being labelled
+#include <climits>
+
+const int COMPONENT_MAX_SEARCHES = 4; //A new wall has at most four neighbours, so a split makes at most four areas.
+
+//Returns a label not used by any square.
+int CComponentIndex::NewLabel()
+{
+	if (!mFreeLabels.empty())
+	{
+		int label = mFreeLabels.back();
+		mFreeLabels.pop_back();
+		return label;
+	}
+	mSizes.push_back(0);
+	return mSizes.size() - 1;
+}
+
+//Changes the label of every square connected to the index from its current label to the new one.
+void CComponentIndex::Relabel(const CTerrainMap& terrain, int index, int newLabel)
+{
+	int oldLabel = mLabels[index];
+	vector<int> toVisit;
+	toVisit.push_back(index);
+	mLabels[index] = newLabel;
+
+	//The map is surrounded by walls, which are never labelled, so the neighbours never need to be checked against the bounds of the map.
+	while (!toVisit.empty())
+	{
+		int current = toVisit.back();
+		toVisit.pop_back();
+		for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+		{
+			int neighbour = current + terrain.Offset(ECompass(direction));
+			if (mLabels[neighbour] == oldLabel)
+			{
+				mLabels[neighbour] = newLabel;
+				toVisit.push_back(neighbour);
+			}
+		}
+	}
+
+	mSizes[newLabel] += mSizes[oldLabel];
+	mSizes[oldLabel] = 0;
+	mFreeLabels.push_back(oldLabel);
+}
+
+//Labels every square of the map.
+void CComponentIndex::Build(const CTerrainMap& terrain)
+{
+	mLabels.assign(terrain.Size(), 0);
+	mSizes.assign(1, 0);
+	mFreeLabels.clear();
+	mNumComponents = 0;
+	mMarks.assign(terrain.Size(), 0);
+	mMarkBase = 0;
+
+	vector<int> toVisit;
+	for (int index = 0; index < terrain.Size(); index++)
+	{
+		if (terrain[index] == ENodeType::wall || mLabels[index] != 0)
+		{
+			continue;
+		}
+
+		//Flood fill the area the square is in.
+		int label = NewLabel();
+		mNumComponents++;
+		mLabels[index] = label;
+		toVisit.push_back(index);
+		while (!toVisit.empty())
+		{
+			int current = toVisit.back();
+			toVisit.pop_back();
+			mSizes[label]++;
+			for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+			{
+				int neighbour = current + terrain.Offset(ECompass(direction));
+				if (terrain[neighbour] != ENodeType::wall && mLabels[neighbour] == 0)
+				{
+					mLabels[neighbour] = label;
+					toVisit.push_back(neighbour);
+				}
+			}
+		}
+	}
+}
+
+//Call after the square at the index has been changed from a wall to a square that can be walked on.
+void CComponentIndex::WallRemoved(const CTerrainMap& terrain, int index)
+{
+	if (mLabels[index] != 0)
+	{
+		return;
+	}
+
+	//Find the largest area next to the square. The square joins it, and so do the others.
+	int largest = 0;
+	for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+	{
+		int label = mLabels[index + terrain.Offset(ECompass(direction))];
+		if (label != 0 && (largest == 0 || mSizes[label] > mSizes[largest]))
+		{
+			largest = label;
+		}
+	}
+
+	if (largest == 0)
+	{
+		largest = NewLabel();
+		mNumComponents++;
+	}
+	mLabels[index] = largest;
+	mSizes[largest]++;
+
+	for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+	{
+		int neighbour = index + terrain.Offset(ECompass(direction));
+		if (mLabels[neighbour] != 0 && mLabels[neighbour] != largest)
+		{
+			Relabel(terrain, neighbour, largest);
+			mNumComponents--;
+		}
+	}
+}
+
+//Call after the square at the index has been changed to a wall.
+void CComponentIndex::WallAdded(const CTerrainMap& terrain, int index)
+{
+	int label = mLabels[index];
+	if (label == 0)
+	{
+		return;
+	}
+	mLabels[index] = 0;
+	mSizes[label]--;
+	if (mSizes[label] == 0)
+	{
+		mFreeLabels.push_back(label);
+		mNumComponents--;
+		return;
+	}
+
+	//Each neighbour of the new wall starts a search. If they are still connected the searches will meet.
+	vector<int> searches[COMPONENT_MAX_SEARCHES]; //The squares each search has visited, in the order they were visited. Also used as the search queue.
+	int heads[COMPONENT_MAX_SEARCHES] = {}; //The next square each search will expand.
+	int groups[COMPONENT_MAX_SEARCHES]; //Searches that have met are joined into a group, which is identified by one of them.
+	bool finished[COMPONENT_MAX_SEARCHES] = {}; //Set for the group when every square its searches can reach has been visited.
+	int numSearches = 0;
+
+	//Marks older than the base are from previous calls. Start again from 0 before the marks overflow.
+	if (mMarkBase > UINT_MAX - 2 * COMPONENT_MAX_SEARCHES)
+	{
+		mMarks.assign(mMarks.size(), 0);
+		mMarkBase = 0;
+	}
+	mMarkBase += COMPONENT_MAX_SEARCHES;
+
+	for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+	{
+		int neighbour = index + terrain.Offset(ECompass(direction));
+		if (mLabels[neighbour] == label)
+		{
+			searches[numSearches].push_back(neighbour);
+			mMarks[neighbour] = mMarkBase + numSearches;
+			groups[numSearches] = numSearches;
+			numSearches++;
+		}
+	}
+
+	auto GroupOf = [&groups](int search)
+	{
+		while (groups[search] != search)
+		{
+			search = groups[search];
+		}
+		return search;
+	};
+
+	//Take turns expanding one square from each search until only one group is still running. That group keeps the label.
+	int running = numSearches;
+	while (running > 1)
+	{
+		for (int search = 0; search < numSearches; search++)
+		{
+			int group = GroupOf(search);
+			if (finished[group] || heads[search] == int(searches[search].size()))
+			{
+				continue;
+			}
+
+			int current = searches[search][heads[search]];
+			heads[search]++;
+			for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+			{
+				int neighbour = current + terrain.Offset(ECompass(direction));
+				if (mLabels[neighbour] != label)
+				{
+					continue;
+				}
+
+				if (mMarks[neighbour] >= mMarkBase && mMarks[neighbour] < mMarkBase + COMPONENT_MAX_SEARCHES)
+				{
+					//Met another search. If it is from another group, the two groups are connected.
+					int otherGroup = GroupOf(mMarks[neighbour] - mMarkBase);
+					if (otherGroup != group)
+					{
+						groups[otherGroup] = group;
+						running--;
+					}
+				}
+				else
+				{
+					mMarks[neighbour] = mMarkBase + search;
+					searches[search].push_back(neighbour);
+				}
+			}
+		}
+
+		//A group whose searches have all run out of squares has found everything it is connected to, so it is a separate area.
+		for (int group = 0; group < numSearches && running > 1; group++)
+		{
+			if (GroupOf(group) != group || finished[group])
+			{
+				continue;
+			}
+
+			bool exhausted = true;
+			for (int search = 0; search < numSearches; search++)
+			{
+				if (GroupOf(search) == group && heads[search] != int(searches[search].size()))
+				{
+					exhausted = false;
+				}
+			}
+			if (!exhausted)
+			{
+				continue;
+			}
+
+			finished[group] = true;
+			running--;
+			int newLabel = NewLabel();
+			mNumComponents++;
+			for (int search = 0; search < numSearches; search++)
+			{
+				if (GroupOf(search) == group)
+				{
+					for (auto it = searches[search].begin(); it != searches[search].end(); it++)
+					{
+						mLabels[*it] = newLabel;
+					}
+					mSizes[newLabel] += searches[search].size();
+					mSizes[label] -= searches[search].size();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,59 @@
+//Leo Croft
+
+// ComponentIndex.h
+// ================
+//
+// Labels each square of a map with the connected area of squares it belongs to
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+
+class CTerrainMap;
+
+// Squares that can reach each other share a label, and walls have no label (0). Two squares with different labels can't have a path between them,
+// so a search can reject the query without looking at the map.
+// The labels are updated as walls are added and removed, at a cost that depends on the size of the smaller areas involved, not the whole map:
+// Removing a wall joins the areas around it by relabelling all but the largest. Adding a wall may split its area, which is found by searching out from
+// each side of the wall at once until all but one of the searches meet or run out of squares; Only the areas that ran out are relabelled.
+class CComponentIndex
+{
+private:
+	vector<int> mLabels; //Indexed the same way as the TerrainMap. 0 for walls.
+	vector<int> mSizes; //The number of squares with each label. mSizes[0] is unused.
+	vector<int> mFreeLabels; //Labels no longer used by any square.
+	int mNumComponents = 0;
+
+	//Marks the squares visited by the searches in WallAdded, so the marks don't need to be cleared between calls.
+	vector<unsigned int> mMarks;
+	unsigned int mMarkBase = 0;
+
+	//Returns a label not used by any square.
+	int NewLabel();
+
+	//Changes the label of every square connected to the index from its current label to the new one.
+	void Relabel(const CTerrainMap& terrain, int index, int newLabel);
+
+public:
+	//Labels every square of the map.
+	void Build(const CTerrainMap& terrain);
+
+	//The label of the square at the index, or 0 if it is a wall.
+	int GetLabel(int index) const
+	{
+		return mLabels[index];
+	}
+
+	//The number of separate areas on the map.
+	int GetNumComponents() const
+	{
+		return mNumComponents;
+	}
+
+	//Call after the square at the index has been changed from a wall to a square that can be walked on.
+	void WallRemoved(const CTerrainMap& terrain, int index);
+
+	//Call after the square at the index has been changed to a wall.
+	void WallAdded(const CTerrainMap& terrain, int index);
+};
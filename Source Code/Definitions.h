@@ -15,6 +15,14 @@
 
 using namespace std;
 
+//Coordinates of a square on the map.
+struct SIntVector
+{
+	int x;
+	int y;
+
+};
+
 enum ECompass
 {
 	North,
@@ -35,8 +43,7 @@ enum ENodeType
 	end
 }; //The type of node also determines the cost of crossing it.
 
-// Maps of any size are implemented as 2D vectors
-using TerrainMap = vector<vector<ENodeType>>;
+// Maps of any size are implemented as a flat grid; See TerrainMap.h
 
 // Represents a node in the search tree.
 struct SNode
@@ -50,6 +57,9 @@ struct SNode
   	
 	//Difference in X + Difference in Y.
 	int CalculateManhattanDistance(int newX, int newY); //Calculate the minimum number of spaces that would be required to reach the goal from the coordinates.
+	//Nodes are created and destroyed for every square a search visits, so they are allocated from a pool rather than the heap. See NodePool.h
+	static void* operator new(size_t size);
+	static void operator delete(void* node);
 };
 
 const int NODE_NOT_FOUND = -1; //Used to identify if the CheckListForBetter function didn't find the node on the list
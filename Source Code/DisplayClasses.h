@@ -22,12 +22,7 @@ private:
 	string mMapSelected; //The map in use. If empty, a map has not been loaded.
 	ESearchType mSearchSelected = ESearchType::NumOfSearches; //The search in use. If "NumOfSearches" (A non-option included for cycling), a selection hasn't been made.
 public:
-	TerrainMap mMapData; //2D array, square, of map data.
-
-	//These NodeLists are used to keep track of the respective lists while stepping through a search.
-	NodeList mOpenList;
-	NodeList mClosedList;
-	unique_ptr<SNode> mpGoal; //To avoid re-declaring the goal every loop.
+	TerrainMap mMapData; //Flat grid of map data, one byte per square.
 
 	//When the Map Handler is created, create the camera and models.
 	//Scale down the models so that it fits a model per unit square.
@@ -67,7 +62,7 @@ public:
 	/** Path/Search demonstration manipulation **/
 	//If there aren't enough models available to demonstrate the search, push more onto the end.
 	//Loop through openlist and closedlist, place them just above the nodes in the list and apply the relevant textures.
-	void SetupSearchDemo();
+	void SetupSearchDemo(const NodeList& openList, const NodeList& closedList);
 
 	//If the first overlay isn't at the spawn position, set all overlays to the spawn position.
 	void HideSearchDemo();
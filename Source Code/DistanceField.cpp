@@ -0,0 +1,159 @@
+//Leo Croft
+
+// DistanceField.cpp
+// =================
+//
+// Implementation of the single source distance field
+//
+
+#include "DistanceField.h" // Declaration of this class
+
+//Terrain costs are at most 3, so every cost on the open list is within 3 of the lowest. One bucket per cost in that window is enough.
+const int DISTANCE_FIELD_BUCKETS = 4;
+
+//Runs Dijkstra's algorithm from the source until every reachable square with a cost up to maxCost has been reached.
+bool CDistanceField::Build(const TerrainMap& terrain, SIntVector source, int maxCost)
+{
+	//When the map is the same size as last time, only the squares reached by the last build need resetting.
+	//This keeps small builds (with a low maxCost) cheap on large maps.
+	if (terrain.Size() == int(mCosts.size()) && terrain.GetStride() == mStride)
+	{
+		for (auto it = mReached.begin(); it != mReached.end(); it++)
+		{
+			mCosts[*it] = UNREACHABLE;
+			mParents[*it] = -1;
+		}
+	}
+	else
+	{
+		mCosts.assign(terrain.Size(), UNREACHABLE);
+		mParents.assign(terrain.Size(), -1);
+	}
+	mReached.clear();
+	mWidth = terrain.GetWidth();
+	mHeight = terrain.GetHeight();
+	mStride = terrain.GetStride();
+	mMapId = terrain.GetId();
+	mMapVersion = terrain.GetVersion();
+	mSource = { -1, -1 };
+
+	if (!terrain.InBounds(source.x, source.y) || terrain.Get(source.x, source.y) == ENodeType::wall)
+	{
+		return false;
+	}
+	mSource = source;
+
+	//Circular bucket queue of indexes (Dial's algorithm). A square may be pushed more than once; Stale entries are skipped when popped.
+	mBuckets.resize(DISTANCE_FIELD_BUCKETS);
+	int sourceIndex = terrain.Index(source.x, source.y);
+	mCosts[sourceIndex] = 0;
+	mReached.push_back(sourceIndex);
+	for (auto it = mBuckets.begin(); it != mBuckets.end(); it++)
+	{
+		(*it).clear(); //Left over if the last build stopped at its maximum cost.
+	}
+	mBuckets[0].push_back(sourceIndex);
+	int queued = 1;
+
+	for (int cost = 0; queued > 0 && cost <= maxCost; cost++)
+	{
+		vector<int>& bucket = mBuckets[cost % DISTANCE_FIELD_BUCKETS];
+		while (!bucket.empty())
+		{
+			int index = bucket.back();
+			bucket.pop_back();
+			queued--;
+			if (mCosts[index] != cost)
+			{
+				continue; //A cheaper route to this square was found after it was pushed.
+			}
+
+			//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+			for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+			{
+				int neighbour = index + terrain.Offset(ECompass(direction));
+				if (terrain[neighbour] == ENodeType::wall)
+				{
+					continue;
+				}
+
+				int newCost = cost + terrain[neighbour];
+				if (mCosts[neighbour] == UNREACHABLE || newCost < mCosts[neighbour])
+				{
+					if (mCosts[neighbour] == UNREACHABLE)
+					{
+						mReached.push_back(neighbour);
+					}
+					mCosts[neighbour] = newCost;
+					mParents[neighbour] = index;
+					mBuckets[newCost % DISTANCE_FIELD_BUCKETS].push_back(neighbour);
+					queued++;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//The cost of the cheapest route from the source to the square, or UNREACHABLE.
+int CDistanceField::CostTo(int x, int y) const
+{
+	if (!IsBuilt() || x < 0 || y < 0 || x >= mWidth || y >= mHeight)
+	{
+		return UNREACHABLE;
+	}
+	return mCosts[(y + 1) * mStride + (x + 1)];
+}
+
+//The direction of the first step of the cheapest route from the square back to the source.
+bool CDistanceField::DirectionToSource(int x, int y, ECompass& direction) const
+{
+	if (CostTo(x, y) == UNREACHABLE)
+	{
+		return false;
+	}
+
+	int index = (y + 1) * mStride + (x + 1);
+	int parent = mParents[index];
+	if (parent == -1)
+	{
+		return false; //The source.
+	}
+
+	if (parent == index + mStride)
+	{
+		direction = ECompass::North;
+	}
+	else if (parent == index + 1)
+	{
+		direction = ECompass::East;
+	}
+	else if (parent == index - mStride)
+	{
+		direction = ECompass::South;
+	}
+	else
+	{
+		direction = ECompass::West;
+	}
+	return true;
+}
+
+//Builds the cheapest route from the source to the square by following the parents back.
+bool CDistanceField::PathTo(int x, int y, NodeList& path) const
+{
+	if (CostTo(x, y) == UNREACHABLE)
+	{
+		return false;
+	}
+
+	//Push each square onto the front of the path to build it backwards, like BuildPath.
+	for (int index = (y + 1) * mStride + (x + 1); index != -1; index = mParents[index])
+	{
+		path.push_front(unique_ptr<SNode>(new SNode));
+		path.front()->x = (index % mStride) - 1;
+		path.front()->y = (index / mStride) - 1;
+	}
+	return true;
+}
@@ -0,0 +1,70 @@
+//Leo Croft
+
+// DistanceField.h
+// ===============
+//
+// Single source distance field: Dijkstra's algorithm run from one square to every reachable square on the map.
+// Once built, the cheapest route from the source to any square is found by following the parents back, without another search.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include <climits>
+
+const int UNREACHABLE = -1; //The cost given to squares that can't be reached from the source.
+const int UNLIMITED_COST = INT_MAX; //Build the whole field rather than stopping at a maximum cost.
+
+// Stores the cost of the cheapest route from the source and the previous square on that route, for every square of the map.
+// Both are indexed the same way as the TerrainMap. Keep one field per frequently used start (such as a spawn point) and query it for each goal.
+// The field is a snapshot; It must be built again if the terrain changes. Matches tells if it is out of date.
+class CDistanceField
+{
+private:
+	vector<int> mCosts; //Cost of the cheapest route from the source, or UNREACHABLE.
+	vector<int> mParents; //Index of the previous square on the cheapest route, or -1 for the source and unreachable squares.
+	vector<vector<int>> mBuckets; //Open list used while building. Kept so the memory is reused when the field is built again.
+	vector<int> mReached; //Indexes of the squares given a cost by the last build, so only those need resetting for the next one.
+	int mWidth = 0;
+	int mHeight = 0;
+	int mStride = 0;
+	unsigned int mMapId = 0; //The map the field was built for, and its version at the time.
+	unsigned int mMapVersion = 0;
+	SIntVector mSource = { -1, -1 };
+
+public:
+	//Runs Dijkstra's algorithm from the source until every reachable square with a cost up to maxCost has been reached.
+	//Squares with a higher cost may be left unreached, or given a route that isn't the cheapest.
+	//Returns false, leaving the field empty, if the source is a wall or off the map.
+	bool Build(const TerrainMap& terrain, SIntVector source, int maxCost = UNLIMITED_COST);
+
+	//True if the field has been built.
+	bool IsBuilt() const
+	{
+		return mSource.x >= 0;
+	}
+
+	SIntVector GetSource() const
+	{
+		return mSource;
+	}
+
+	//True if the field was built for this map, and the map hasn't changed since.
+	bool Matches(const TerrainMap& terrain) const
+	{
+		return terrain.GetId() == mMapId && terrain.GetVersion() == mMapVersion;
+	}
+
+	//The cost of the cheapest route from the source to the square, or UNREACHABLE.
+	int CostTo(int x, int y) const;
+
+	//The direction of the first step of the cheapest route from the square back to the source.
+	//Moving onto a square costs the same whichever direction it is entered from, so this is the reverse of the route from the source.
+	//Returns false at the source itself and at squares that can't be reached.
+	bool DirectionToSource(int x, int y, ECompass& direction) const;
+
+	//Builds the cheapest route from the source to the square by following the parents back. The path runs from the source to the square.
+	//Returns false, leaving the path empty, if the square can't be reached.
+	bool PathTo(int x, int y, NodeList& path) const;
+};
@@ -0,0 +1,74 @@
+//Leo Croft
+
+// FlowField.cpp
+// =============
+//
+// Implementation of the flow field
+//
+
+#include "FlowField.h" // Declaration of this class
+
+//Searches out from the goal over the whole map. Returns false if the goal is a wall or off the map.
+bool CFlowField::Build(const TerrainMap& terrain, SIntVector goal)
+{
+	mPatched = false;
+	return mField.Build(terrain, goal);
+}
+
+//Moves the goal, patching the field around it if it is close to the goal of the last full build.
+bool CFlowField::MoveGoal(const TerrainMap& terrain, SIntVector goal)
+{
+	if (!mField.IsBuilt() || !mField.Matches(terrain) || mField.CostTo(goal.x, goal.y) == UNREACHABLE)
+	{
+		return Build(terrain, goal);
+	}
+
+	SIntVector fieldGoal = mField.GetSource();
+	if (goal.x == fieldGoal.x && goal.y == fieldGoal.y)
+	{
+		mPatched = false;
+		return true;
+	}
+
+	//The cost of a route only counts the squares entered, so the cost from the new goal to the old one is
+	//the cost the other way, minus the new goal's terrain, plus the old goal's terrain.
+	int patchCost = mField.CostTo(goal.x, goal.y) - terrain.Get(goal.x, goal.y) + terrain.Get(fieldGoal.x, fieldGoal.y);
+	if (patchCost > FLOW_FIELD_MAX_PATCH_COST)
+	{
+		return Build(terrain, goal);
+	}
+
+	//Every square the old field could lead an agent to before it enters the patch is on the way to the old goal,
+	//and the old goal is inside the patch, so every agent reaches the patch and then the new goal.
+	mPatched = true;
+	return mPatch.Build(terrain, goal, patchCost);
+}
+
+//The direction an agent on the square should move in to reach the goal.
+bool CFlowField::GetDirection(int x, int y, ECompass& direction) const
+{
+	if (mPatched && mPatch.CostTo(x, y) != UNREACHABLE)
+	{
+		return mPatch.DirectionToSource(x, y, direction);
+	}
+	return mField.DirectionToSource(x, y, direction);
+}
+
+//Moves the position one square along the field.
+bool CFlowField::Step(SIntVector& position) const
+{
+	ECompass direction;
+	if (!GetDirection(position.x, position.y, direction))
+	{
+		return false;
+	}
+
+	switch (direction)
+	{
+	case ECompass::North: position.y++; break;
+	case ECompass::East: position.x++; break;
+	case ECompass::South: position.y--; break;
+	default: position.x--; break;
+	}
+	return true;
+}
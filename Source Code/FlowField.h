@@ -0,0 +1,54 @@
+//Leo Croft
+
+// FlowField.h
+// ===========
+//
+// Flow field for moving many agents towards one shared goal.
+// A single search out from the goal gives every square the direction of its next step towards the goal,
+// so any number of agents can follow it at a constant cost per step instead of each running FindPath.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include "DistanceField.h" // Search out from the goal
+
+//The largest cost between the goal and the goal the field was last fully built for that MoveGoal will patch. Beyond this the field is rebuilt.
+const int FLOW_FIELD_MAX_PATCH_COST = 64;
+
+// The field is a distance field with the goal as its source. Moving onto a square costs the same whichever direction it is entered from,
+// so the cheapest route from any square to the goal is the cheapest route from the goal to that square in reverse, and the next step
+// from a square is towards its parent in the distance field.
+//
+// When the goal moves a short distance, only a patch around the new goal is searched, just large enough to cover the old goal.
+// Squares in the patch step towards the new goal. Squares outside it follow the old field, which always leads into the patch.
+// Agents outside the patch may take a slightly longer route than the cheapest, by at most about twice the cost between the two goals.
+// The field is a snapshot. MoveGoal rebuilds it in full if the terrain has changed; Otherwise call Build again after changing the terrain.
+class CFlowField
+{
+private:
+	CDistanceField mField; //Distances out from the goal of the last full build.
+	CDistanceField mPatch; //Distances out from the current goal, covering the squares up to the goal of the last full build.
+	bool mPatched = false; //True if the goal has moved since the last full build.
+
+public:
+	//Searches out from the goal over the whole map. Returns false if the goal is a wall or off the map.
+	bool Build(const TerrainMap& terrain, SIntVector goal);
+
+	//Moves the goal. If it is close to the goal of the last full build, only a patch around it is searched. Otherwise the field is rebuilt.
+	//Returns false if the goal is a wall or off the map.
+	bool MoveGoal(const TerrainMap& terrain, SIntVector goal);
+
+	SIntVector GetGoal() const
+	{
+		return (mPatched) ? mPatch.GetSource() : mField.GetSource();
+	}
+
+	//The direction an agent on the square should move in to reach the goal.
+	//Returns false if the agent is on the goal, or the goal can't be reached from the square.
+	bool GetDirection(int x, int y, ECompass& direction) const;
+
+	//Moves the position one square along the field. Returns false, leaving the position unchanged, if it is on the goal or can't reach it.
+	bool Step(SIntVector& position) const;
+};
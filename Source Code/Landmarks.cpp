@@ -0,0 +1,214 @@
+//Leo Croft
+
+// Landmarks.cpp
+// =============
+//
+// Implementation of the landmark tables
+//
+
+#include "Landmarks.h" // Declaration of this class
+#include "DistanceField.h" // Costs from each landmark
+#include <fstream>
+
+const char LANDMARK_FILE_MAGIC[4] = { 'A', 'L', 'T', '1' }; //Identifies a landmark file, and the version of its layout.
+
+//Picks the landmarks and builds their tables. Takes one Dijkstra search over the whole map per landmark.
+void CLandmarks::Build(const TerrainMap& terrain, int numLandmarks)
+{
+	mLandmarks.clear();
+	mCosts.clear();
+	mNumLandmarks = 0;
+	mWidth = terrain.GetWidth();
+	mHeight = terrain.GetHeight();
+	mStride = terrain.GetStride();
+	mContentHash = terrain.ContentHash();
+	mMapId = terrain.GetId();
+	mMapVersion = terrain.GetVersion();
+	mTerrain.resize(terrain.Size());
+	for (int i = 0; i < terrain.Size(); i++)
+	{
+		mTerrain[i] = terrain[i];
+	}
+
+	//Start from the first square that can be walked on. The first landmark is the square furthest from it.
+	SIntVector next = { -1, -1 };
+	for (int y = 0; y < mHeight && next.x < 0; y++)
+	{
+		for (int x = 0; x < mWidth && next.x < 0; x++)
+		{
+			if (terrain.Get(x, y) != ENodeType::wall)
+			{
+				next = { x, y };
+			}
+		}
+	}
+	if (next.x < 0)
+	{
+		return;
+	}
+
+	CDistanceField field;
+	vector<int> nearest(terrain.Size(), UNREACHABLE); //The cost from the nearest landmark to each square.
+	vector<vector<int>> tables; //The costs from each landmark, indexed the same way as the TerrainMap.
+	bool seeded = false;
+
+	while (int(tables.size()) < numLandmarks)
+	{
+		field.Build(terrain, next);
+		if (seeded)
+		{
+			tables.push_back(vector<int>(terrain.Size(), UNREACHABLE));
+			mLandmarks.push_back(terrain.Index(next.x, next.y));
+		}
+
+		//Record the costs, and find the square that is now furthest from every landmark.
+		int furthestCost = 0;
+		SIntVector furthest = next;
+		for (int y = 0; y < mHeight; y++)
+		{
+			for (int x = 0; x < mWidth; x++)
+			{
+				int index = terrain.Index(x, y);
+				int cost = field.CostTo(x, y);
+				if (cost == UNREACHABLE)
+				{
+					continue;
+				}
+
+				if (seeded)
+				{
+					tables.back()[index] = cost;
+					nearest[index] = (nearest[index] == UNREACHABLE) ? cost : min(nearest[index], cost);
+				}
+				else
+				{
+					nearest[index] = cost; //The starting square isn't a landmark, so its costs are only used to pick the first one.
+				}
+
+				if (nearest[index] > furthestCost)
+				{
+					furthestCost = nearest[index];
+					furthest = { x, y };
+				}
+			}
+		}
+
+		if (!seeded)
+		{
+			nearest.assign(terrain.Size(), UNREACHABLE);
+			seeded = true;
+		}
+		else if (furthestCost == 0)
+		{
+			break; //Every square that can be reached is already a landmark.
+		}
+		next = furthest;
+	}
+
+	//Interleave the tables, so every landmark's cost for a square is read from the same cache line.
+	mNumLandmarks = tables.size();
+	mCosts.resize(size_t(terrain.Size()) * mNumLandmarks);
+	for (int index = 0; index < terrain.Size(); index++)
+	{
+		for (int landmark = 0; landmark < mNumLandmarks; landmark++)
+		{
+			mCosts[size_t(index) * mNumLandmarks + landmark] = tables[landmark][index];
+		}
+	}
+}
+
+//A lower bound on the cost of the cheapest route between the squares. Only valid if the tables match the map being searched.
+int CLandmarks::LowerBound(int fromX, int fromY, int toX, int toY) const
+{
+	int from = (fromY + 1) * mStride + (fromX + 1);
+	int to = (toY + 1) * mStride + (toX + 1);
+	const int* fromCosts = &mCosts[size_t(from) * mNumLandmarks];
+	const int* toCosts = &mCosts[size_t(to) * mNumLandmarks];
+	int terrainDifference = mTerrain[to] - mTerrain[from];
+
+	int bound = 0;
+	for (int landmark = 0; landmark < mNumLandmarks; landmark++)
+	{
+		//A landmark in a different area of the map says nothing about the route.
+		if (fromCosts[landmark] == UNREACHABLE || toCosts[landmark] == UNREACHABLE)
+		{
+			continue;
+		}
+		int difference = toCosts[landmark] - fromCosts[landmark];
+		bound = max(bound, max(difference, terrainDifference - difference));
+	}
+	return bound;
+}
+
+//Writes the tables to a binary file. Returns false if the file can't be written.
+//The layout is the magic number, the width, height and number of landmarks, the content hash, the landmark indexes, then the interleaved costs.
+bool CLandmarks::Save(const string& fileName) const
+{
+	ofstream writer(fileName, ios::binary);
+	if (!writer)
+	{
+		return false;
+	}
+
+	int32_t header[3] = { mWidth, mHeight, mNumLandmarks };
+	writer.write(LANDMARK_FILE_MAGIC, sizeof(LANDMARK_FILE_MAGIC));
+	writer.write(reinterpret_cast<const char*>(header), sizeof(header));
+	writer.write(reinterpret_cast<const char*>(&mContentHash), sizeof(mContentHash));
+	writer.write(reinterpret_cast<const char*>(mLandmarks.data()), mLandmarks.size() * sizeof(int));
+	writer.write(reinterpret_cast<const char*>(mCosts.data()), mCosts.size() * sizeof(int));
+	return bool(writer);
+}
+
+//Reads tables written by Save. Returns false, leaving the tables unchanged, if the file can't be read or was saved for a map with different contents.
+bool CLandmarks::Load(const string& fileName, const TerrainMap& terrain)
+{
+	ifstream reader(fileName, ios::binary);
+	if (!reader)
+	{
+		return false;
+	}
+
+	char magic[sizeof(LANDMARK_FILE_MAGIC)];
+	int32_t header[3];
+	uint64_t contentHash;
+	reader.read(magic, sizeof(magic));
+	reader.read(reinterpret_cast<char*>(header), sizeof(header));
+	reader.read(reinterpret_cast<char*>(&contentHash), sizeof(contentHash));
+	if (!reader || !equal(magic, magic + sizeof(magic), LANDMARK_FILE_MAGIC) || header[0] != terrain.GetWidth() || header[1] != terrain.GetHeight() ||
+		header[2] <= 0 || contentHash != terrain.ContentHash())
+	{
+		return false;
+	}
+
+	int numLandmarks = header[2];
+	vector<int> landmarks(numLandmarks);
+	vector<int> costs(size_t(terrain.Size()) * numLandmarks);
+	reader.read(reinterpret_cast<char*>(landmarks.data()), landmarks.size() * sizeof(int));
+	reader.read(reinterpret_cast<char*>(costs.data()), costs.size() * sizeof(int));
+	if (!reader)
+	{
+		return false;
+	}
+
+	mNumLandmarks = numLandmarks;
+	mLandmarks.swap(landmarks);
+	mCosts.swap(costs);
+	mWidth = terrain.GetWidth();
+	mHeight = terrain.GetHeight();
+	mStride = terrain.GetStride();
+	mContentHash = contentHash;
+	mMapId = terrain.GetId();
+	mMapVersion = terrain.GetVersion();
+	mTerrain.resize(terrain.Size());
+	for (int i = 0; i < terrain.Size(); i++)
+	{
+		mTerrain[i] = terrain[i];
+	}
+	return true;
+}
+
+//The name of the landmark file kept next to a map file.
+string LandmarkFileName(const string& mapFile)
+{
+	return mapFile + LANDMARK_FILE_EXTENSION;
+}
@@ -0,0 +1,70 @@
+//Leo Croft
+
+// Landmarks.h
+// ===========
+//
+// Landmark tables for the ALT (A*, Landmarks, Triangle inequality) heuristic
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include <string>
+
+const int DEFAULT_NUM_LANDMARKS = 8;
+const string LANDMARK_FILE_EXTENSION = ".landmarks"; //Added to the name of the map file, so the tables are saved next to the map.
+
+// A few squares are picked as landmarks, and the exact cost of the cheapest route from each landmark to every square is stored.
+// For any square n and goal g, the triangle inequality gives a lower bound on the cost from n to g from each landmark L:
+//   cost(L, g) - cost(L, n)     and     cost(n, L) - cost(g, L)
+// Moving onto a square costs the same from any direction, so the route from n to L is the reverse of the route from L to n, and
+// cost(n, L) = cost(L, n) + terrain(L) - terrain(n). Only one table per landmark is needed for both bounds.
+// The bounds are consistent, so A* using them (or the larger of them and the Manhattan distance) still finds the cheapest path.
+//
+// Landmarks are picked furthest first: Each new landmark is the square furthest from the landmarks already picked, which places them
+// around the edges of the map where they give the tightest bounds.
+// The tables are a snapshot of the map. They are only used with the map they were built for (or a map loaded with the same contents),
+// until it is changed.
+class CLandmarks
+{
+private:
+	int mNumLandmarks = 0;
+	vector<int> mLandmarks; //The index of each landmark on the map.
+	vector<int> mCosts; //The cost from each landmark to each square, or UNREACHABLE. The landmarks for a square are next to each other: [index * mNumLandmarks + landmark].
+	vector<uint8_t> mTerrain; //The terrain of each square, for the second bound.
+	int mWidth = 0;
+	int mHeight = 0;
+	int mStride = 0;
+	uint64_t mContentHash = 0;
+	unsigned int mMapId = 0; //The map the tables are known to match, and its version at the time.
+	unsigned int mMapVersion = 0;
+
+public:
+	//Picks the landmarks and builds their tables. Takes one Dijkstra search over the whole map per landmark.
+	//Fewer landmarks are picked if the map has fewer squares that can be walked on.
+	void Build(const TerrainMap& terrain, int numLandmarks = DEFAULT_NUM_LANDMARKS);
+
+	//True if the tables were built or loaded for the map, and the map hasn't changed since.
+	bool Matches(const TerrainMap& terrain) const
+	{
+		return mNumLandmarks > 0 && terrain.GetId() == mMapId && terrain.GetVersion() == mMapVersion;
+	}
+
+	int GetNumLandmarks() const
+	{
+		return mNumLandmarks;
+	}
+
+	//A lower bound on the cost of the cheapest route between the squares. Only valid if the tables match the map being searched.
+	int LowerBound(int fromX, int fromY, int toX, int toY) const;
+
+	//Writes the tables to a binary file. Returns false if the file can't be written.
+	bool Save(const string& fileName) const;
+
+	//Reads tables written by Save. Returns false, leaving the tables unchanged, if the file can't be read or was saved for a map with different contents.
+	bool Load(const string& fileName, const TerrainMap& terrain);
+};
+
+//The name of the landmark file kept next to a map file.
+string LandmarkFileName(const string& mapFile);
@@ -12,18 +12,14 @@
 //This definitions header is only used by Pathfinding.cpp, so it's safe to include these here. Also allows access to Enums and other stuff.
 #include "Search.h"
 #include "SearchFactory.h"
+#include "SearchContext.h" //Lets a search run across several frames
+#include "PathService.h" //Runs searches on a background thread
+#include "MapLoader.h" //Map file parsing, shared with the command line tools
 #include <math.h>
 
 using namespace tle;
 using namespace std;
 
-struct SIntVector
-{
-	int x;
-	int y;
-
-};
-
 const unsigned short BASE_BLOCK_NUMBER = 100; //The number of models created for the expected size of grid (10x10)
 
 const float SPAWN_Y = -50.0f; //This is the y coordinate where world objects are placed when not in use. It is hidden above the camera, out of view.
@@ -66,23 +62,20 @@ const string MAP_INPUT_PROMPT = "See CMD";
 const string NODE_SELECTION_INFO = "WASD to select"; //WASD to select, Enter to confirm.
 const string END_DEMO_OUTPUT = "Stop Path"; //Press enter to stop pathing.
 const string SEARCH_FAIL = "Search failed";
-const string ASTAR_SEARCH_COUNT_OUTPUT = "Number of Searches during A* Search: ";
+const string SEARCH_RUNNING = "Searching..."; //Press enter to go back to the menu while the search carries on.
+const string SEARCH_COUNT_OUTPUT = "Nodes expanded during search: ";
 
-const string MAP_FILE_EXTENSION = "Map.txt";
 const string MAP_FILE_SUCCESS = "Map file confirmed.";
 const string MAP_FILE_ERROR = "Map file not found; Try again.";
 
-const string COORD_FILE_EXTENSION = "Coords.txt";
 const string COORD_FILE_SUCCESS = "Cooord file confirmed.";
 const string COORD_FILE_ERROR = "Coord file not found; Try again.";
 
-const string PATH_OUTPUT_FILE = "output.txt"; //The name of the file to output the path to.
-
 //UI output for selecting options
 enum EOptions { ChooseMap, ChooseStart, ChooseEnd, ChooseSearch, FindPath, StepPath, NumOfOptions }; //NumOfOptions should always be last
 const string OPTIONS[EOptions::NumOfOptions] = { "Choose Map", "Choose Start", "Choose End",
 												 "Choose Search", "Use ", "Step " }; // "Use <Algorithm>" and "Step <Algorithm>"
-const string SEARCH_TYPES[ESearchType::NumOfSearches] = { "Breadth First", "AStar" }; //The text outputs so users can pick their search.
+const string SEARCH_TYPES[ESearchType::NumOfSearches] = { "Breadth First", "Dijkstra", "AStar", "AStar (Buckets)", "D* Lite", "HPA*", "Bidirectional BFS", "Bidirectional AStar", "Jump Point (JPS4)", "ARA*" }; //The text outputs so users can pick their search.
 
 const string PATH_TEXTURE = "PathArrow.png"; //This texture is used to show the nodes on the path.
 const string OPENLIST_TEXTURE = "openListDisplay.png"; //This texture is used to show nodes in the openlist.
@@ -0,0 +1,185 @@
+//Leo Croft
+
+// MapGenerator.cpp
+// ================
+//
+// Generates maps of any size for the benchmark tools
+//
+
+#include "MapGenerator.h" // Declarations of these functions
+#include <random>
+
+const int RANDOM_WALL_PERCENT = 25; //Percentage of squares that are walls in a RandomObstacles map.
+const int MIXED_WALL_PERCENT = 8; //Percentage of squares that are walls in a MixedTerrain map.
+const int MIXED_PATCHES_PER_SIDE = 16; //A MixedTerrain map is divided into roughly this many patches along each side.
+const int CORNER_CLEAR_SIZE = 3; //The size of the clear area left in opposite corners, so the start is never walled in.
+
+//Every square is given a random type, with walls scattered over it.
+static void GenerateRandomObstacles(TerrainMap& terrain, mt19937& generator)
+{
+	uniform_int_distribution<int> percent(0, 99);
+	uniform_int_distribution<int> terrainCost(ENodeType::clear, ENodeType::water);
+
+	for (int y = 0; y < terrain.GetHeight(); y++)
+	{
+		for (int x = 0; x < terrain.GetWidth(); x++)
+		{
+			terrain.Set(x, y, (percent(generator) < RANDOM_WALL_PERCENT) ? ENodeType::wall : ENodeType(terrainCost(generator)));
+		}
+	}
+}
+
+//Carves a perfect maze (exactly one route between any two corridor squares) using a depth first search with an explicit stack.
+//Corridors are on the even coordinates, and the squares between them are opened up as the maze is carved.
+static void GenerateMaze(TerrainMap& terrain, mt19937& generator)
+{
+	terrain.Resize(terrain.GetWidth(), terrain.GetHeight(), ENodeType::wall);
+
+	const int directionX[4] = { 0, 2, 0, -2 }; //In ECompass order.
+	const int directionY[4] = { 2, 0, -2, 0 };
+
+	vector<SIntVector> stack;
+	stack.push_back({ 0, 0 });
+	terrain.Set(0, 0, ENodeType::clear);
+
+	while (!stack.empty())
+	{
+		SIntVector current = stack.back();
+
+		//Find the neighbouring corridor squares that haven't been carved yet.
+		int options[4];
+		int numOptions = 0;
+		for (int direction = 0; direction < 4; direction++)
+		{
+			int x = current.x + directionX[direction];
+			int y = current.y + directionY[direction];
+			if (terrain.InBounds(x, y) && terrain.Get(x, y) == ENodeType::wall)
+			{
+				options[numOptions] = direction;
+				numOptions++;
+			}
+		}
+
+		if (numOptions == 0)
+		{
+			stack.pop_back();
+			continue;
+		}
+
+		//Carve through to a random one of them.
+		int direction = options[uniform_int_distribution<int>(0, numOptions - 1)(generator)];
+		terrain.Set(current.x + directionX[direction] / 2, current.y + directionY[direction] / 2, ENodeType::clear);
+		terrain.Set(current.x + directionX[direction], current.y + directionY[direction], ENodeType::clear);
+		stack.push_back({ current.x + directionX[direction], current.y + directionY[direction] });
+	}
+}
+
+//The map is divided into patches of clear, wood or water, with walls scattered over it.
+static void GenerateMixedTerrain(TerrainMap& terrain, mt19937& generator)
+{
+	uniform_int_distribution<int> percent(0, 99);
+	uniform_int_distribution<int> terrainCost(ENodeType::clear, ENodeType::water);
+
+	int patchSize = max(terrain.GetWidth(), terrain.GetHeight()) / MIXED_PATCHES_PER_SIDE;
+	if (patchSize < 1)
+	{
+		patchSize = 1;
+	}
+	int patchesX = (terrain.GetWidth() + patchSize - 1) / patchSize;
+	int patchesY = (terrain.GetHeight() + patchSize - 1) / patchSize;
+
+	vector<ENodeType> patches(patchesX * patchesY);
+	for (auto it = patches.begin(); it != patches.end(); it++)
+	{
+		*it = ENodeType(terrainCost(generator));
+	}
+
+	for (int y = 0; y < terrain.GetHeight(); y++)
+	{
+		for (int x = 0; x < terrain.GetWidth(); x++)
+		{
+			ENodeType patch = patches[(y / patchSize) * patchesX + (x / patchSize)];
+			terrain.Set(x, y, (percent(generator) < MIXED_WALL_PERCENT) ? ENodeType::wall : patch);
+		}
+	}
+}
+
+//Finds the square reachable from the start that is closest to the given target, using a flood fill.
+static SIntVector FindReachableNear(TerrainMap& terrain, SIntVector start, SIntVector target)
+{
+	vector<bool> visited(terrain.Size(), false);
+	deque<int> toVisit;
+	toVisit.push_back(terrain.Index(start.x, start.y));
+	visited[toVisit.back()] = true;
+
+	SIntVector best = start;
+	int bestDistance = abs(start.x - target.x) + abs(start.y - target.y);
+
+	const ECompass directions[4] = { ECompass::North, ECompass::East, ECompass::South, ECompass::West };
+	while (!toVisit.empty())
+	{
+		int index = toVisit.front();
+		toVisit.pop_front();
+
+		SIntVector square = { terrain.IndexToX(index), terrain.IndexToY(index) };
+		int distance = abs(square.x - target.x) + abs(square.y - target.y);
+		if (distance < bestDistance)
+		{
+			best = square;
+			bestDistance = distance;
+		}
+
+		//The border is walls, so there is no need to check the bounds.
+		for (int direction = 0; direction < 4; direction++)
+		{
+			int neighbour = index + terrain.Offset(directions[direction]);
+			if (terrain[neighbour] != ENodeType::wall && !visited[neighbour])
+			{
+				visited[neighbour] = true;
+				toVisit.push_back(neighbour);
+			}
+		}
+	}
+
+	return best;
+}
+
+//Fills the terrain with a generated map. The same seed always gives the same map.
+void GenerateMap(TerrainMap& terrain, int width, int height, EMapStyle style, unsigned int seed, SIntVector& start, SIntVector& goal)
+{
+	mt19937 generator(seed);
+	terrain.Resize(width, height);
+
+	switch (style)
+	{
+	case RandomObstacles:
+		GenerateRandomObstacles(terrain, generator);
+		break;
+	case Maze:
+		GenerateMaze(terrain, generator);
+		break;
+	case MixedTerrain:
+		GenerateMixedTerrain(terrain, generator);
+		break;
+	default: //Open maps are left clear.
+		break;
+	}
+
+	//The bottom left corner is always part of a maze. For the other styles, clear the corners so the start is never walled in.
+	if (style != EMapStyle::Maze)
+	{
+		for (int y = 0; y < CORNER_CLEAR_SIZE && y < height; y++)
+		{
+			for (int x = 0; x < CORNER_CLEAR_SIZE && x < width; x++)
+			{
+				terrain.Set(x, y, ENodeType::clear);
+				terrain.Set(width - 1 - x, height - 1 - y, ENodeType::clear);
+			}
+		}
+	}
+
+	terrain.BuildComponentIndex();
+
+	start = { 0, 0 };
+	goal = FindReachableNear(terrain, start, { width - 1, height - 1 });
+}
@@ -0,0 +1,29 @@
+//Leo Croft
+
+// MapGenerator.h
+// ==============
+//
+// Generates maps of any size for the benchmark tools
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include <string>
+
+//The kinds of map that can be generated.
+enum EMapStyle
+{
+	OpenMap, //Every square is clear.
+	RandomObstacles, //Scattered walls over a mix of terrain types.
+	Maze, //A perfect maze of clear corridors one square wide.
+	MixedTerrain, //Large patches of clear, wood and water with some walls between them.
+	NumOfMapStyles
+};
+
+const string MAP_STYLE_NAMES[EMapStyle::NumOfMapStyles] = { "Open", "RandomObstacles", "Maze", "MixedTerrain" };
+
+//Fills the terrain with a generated map. The same seed always gives the same map.
+//Start and goal are set to clear squares near opposite corners that are reachable from each other.
+void GenerateMap(TerrainMap& terrain, int width, int height, EMapStyle style, unsigned int seed, SIntVector& start, SIntVector& goal);
@@ -0,0 +1,256 @@
+//Leo Croft
+
+// MapLoader.cpp
+// =============
+//
+// Reading map and coordinate files, and writing path files
+//
+
+#include "MapLoader.h" // Declarations of these functions
+#include <fstream>
+#include <sstream>
+
+//Reads a map file into the terrain. Returns false if the file can't be opened or isn't a valid map, in which case the terrain is unchanged.
+bool LoadMapFile(const string& fileName, TerrainMap& terrain)
+{
+	ifstream mapReader(fileName);
+	if (!mapReader)
+	{
+		return false;
+	}
+
+	//Getting the dimensions from the first line
+	int width = 0;
+	int height = 0;
+	mapReader >> width >> height;
+	if (!mapReader || width <= 0 || height <= 0)
+	{
+		return false;
+	}
+
+	//Read into a separate map so the terrain is left alone if the file turns out to be invalid.
+	TerrainMap newTerrain(width, height);
+
+	//The file starts with the top row, which has the highest z coordinate.
+	for (int z = height - 1; z >= 0; z--)
+	{
+		//Read each of the individual spaces from the file as characters, then convert it into an integer and then into the node type.
+		for (int x = 0; x < width; x++)
+		{
+			char nodeScore;
+			mapReader >> nodeScore;
+
+			//Before being parsed into the type, the character has the ascii character for 0 removed to translate it into an int.
+			int type = nodeScore - '0';
+			if (!mapReader || type < ENodeType::wall || type > ENodeType::water)
+			{
+				return false;
+			}
+			newTerrain.Set(x, z, ENodeType(type));
+		}
+	}
+
+	newTerrain.BuildComponentIndex();
+	terrain = move(newTerrain);
+	return true;
+}
+
+//Reads the next query from a coordinate stream. Returns false at the end of the stream, or if the query can't be read.
+bool ReadQuery(istream& input, SIntVector& start, SIntVector& end)
+{
+	input >> ws;
+	if (input.eof())
+	{
+		return false;
+	}
+
+	SIntVector newStart;
+	SIntVector newEnd;
+	input >> newStart.x >> newStart.y >> newEnd.x >> newEnd.y;
+	if (!input)
+	{
+		input.clear(ios::failbit); //A query cut short by the end of the stream is still invalid, so clear eof.
+		return false;
+	}
+
+	start = newStart;
+	end = newEnd;
+	return true;
+}
+
+//Reads the first query from a coordinate file. Returns false if the file can't be opened or read.
+bool LoadCoordFile(const string& fileName, SIntVector& start, SIntVector& end)
+{
+	ifstream coordReader(fileName);
+	if (!coordReader)
+	{
+		return false;
+	}
+
+	return ReadQuery(coordReader, start, end);
+}
+
+//Writes the path to a file, one "x, y" line per node. Returns false if the file can't be opened.
+bool SavePathFile(const string& fileName, NodeList& path)
+{
+	ofstream outFile(fileName);
+	if (!outFile)
+	{
+		return false;
+	}
+
+	for (NodeList::iterator it = path.begin(); it != path.end(); it++)
+	{
+		outFile << (*it)->x << ", " << (*it)->y << '\n'; //The file is flushed once when it is closed, rather than on every line.
+	}
+	return true;
+}
+
+//Appends the result of one query of a batch as a line: "id cost length x,y x,y ...".
+void AppendPathRecord(string& record, long long id, int cost, NodeList& path)
+{
+	record += to_string(id);
+	record += ' ';
+	record += to_string(cost);
+	record += ' ';
+	record += to_string(path.size());
+	for (auto it = path.begin(); it != path.end(); it++)
+	{
+		record += ' ';
+		record += to_string((*it)->x);
+		record += ',';
+		record += to_string((*it)->y);
+	}
+	record += '\n';
+}
+
+//Converts a Moving AI terrain character into a node type. Returns false for characters that aren't part of the format.
+static bool MovingAITerrain(char character, ENodeType& type)
+{
+	switch (character)
+	{
+	case '.':
+	case 'G':
+		type = ENodeType::clear;
+		return true;
+	case 'S':
+		type = ENodeType::wood;
+		return true;
+	case 'W':
+		type = ENodeType::water;
+		return true;
+	case '@':
+	case 'O':
+	case 'T':
+		type = ENodeType::wall;
+		return true;
+	default:
+		return false;
+	}
+}
+
+//Reads a Moving AI map (.map) file into the terrain. Returns false if the file can't be opened or isn't a valid map, in which case the terrain is unchanged.
+bool LoadMovingAIMap(const string& fileName, TerrainMap& terrain)
+{
+	ifstream mapReader(fileName);
+	if (!mapReader)
+	{
+		return false;
+	}
+
+	//The header is a list of "key value" lines, ending with a line containing "map".
+	int width = 0;
+	int height = 0;
+	string key;
+	while (mapReader >> key && key != "map")
+	{
+		if (key == "height")
+		{
+			mapReader >> height;
+		}
+		else if (key == "width")
+		{
+			mapReader >> width;
+		}
+		else
+		{
+			string value;
+			mapReader >> value; //The type line, which is always "octile".
+		}
+	}
+	if (!mapReader || width <= 0 || height <= 0)
+	{
+		return false;
+	}
+
+	TerrainMap newTerrain(width, height);
+
+	//The first row in the file is y = 0 in Moving AI coordinates, which is the top row of the map.
+	for (int row = 0; row < height; row++)
+	{
+		string line;
+		mapReader >> line;
+		if (!mapReader || int(line.size()) < width)
+		{
+			return false;
+		}
+
+		for (int x = 0; x < width; x++)
+		{
+			ENodeType type;
+			if (!MovingAITerrain(line[x], type))
+			{
+				return false;
+			}
+			newTerrain.Set(x, height - 1 - row, type);
+		}
+	}
+
+	newTerrain.BuildComponentIndex();
+	terrain = move(newTerrain);
+	return true;
+}
+
+//Reads every scenario from a Moving AI scenario (.scen) file. Returns false if the file can't be opened or a line is invalid.
+bool LoadMovingAIScenarios(const string& fileName, vector<SScenario>& scenarios)
+{
+	ifstream scenarioReader(fileName);
+	if (!scenarioReader)
+	{
+		return false;
+	}
+
+	//The first line is the version.
+	string line;
+	if (!getline(scenarioReader, line) || line.compare(0, 7, "version") != 0)
+	{
+		return false;
+	}
+
+	vector<SScenario> newScenarios;
+	while (getline(scenarioReader, line))
+	{
+		if (line.empty() || line == "\r")
+		{
+			continue;
+		}
+
+		//Fields are separated by tabs: bucket, map, map width, map height, start x, start y, goal x, goal y, optimal length.
+		stringstream fields(line);
+		SScenario scenario;
+		fields >> scenario.mBucket >> scenario.mMapName >> scenario.mMapWidth >> scenario.mMapHeight;
+		fields >> scenario.mStart.x >> scenario.mStart.y >> scenario.mGoal.x >> scenario.mGoal.y >> scenario.mOptimalLength;
+		if (!fields)
+		{
+			return false;
+		}
+
+		//Flip the rows so that y = 0 is the bottom row.
+		scenario.mStart.y = scenario.mMapHeight - 1 - scenario.mStart.y;
+		scenario.mGoal.y = scenario.mMapHeight - 1 - scenario.mGoal.y;
+		newScenarios.push_back(scenario);
+	}
+
+	scenarios = move(newScenarios);
+	return true;
+}
@@ -0,0 +1,59 @@
+//Leo Croft
+
+// MapLoader.h
+// ===========
+//
+// Reading map and coordinate files, and writing path files.
+// Shared by the TL-Engine program and the command line tools, so it must not use any tle types.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include <string>
+#include <vector>
+#include <istream>
+
+const string MAP_FILE_EXTENSION = "Map.txt";
+const string COORD_FILE_EXTENSION = "Coords.txt";
+const string PATH_OUTPUT_FILE = "output.txt"; //The name of the file to output the path to.
+
+//Reads a map file into the terrain. Returns false if the file can't be opened or isn't a valid map, in which case the terrain is unchanged.
+//The first line holds the width and height, followed by one digit per square (the ENodeType) starting from the top row.
+bool LoadMapFile(const string& fileName, TerrainMap& terrain);
+
+//A coordinate file holds any number of queries, each four numbers: The start x and y, then the end x and y.
+//Files written for the TL-Engine program have the start on the first line and the end on the second, which is a file with one query.
+
+//Reads the next query from a coordinate stream. Returns false at the end of the stream, or if the query can't be read.
+//At the end of the stream eof() is set; If the query is invalid eof() is clear, so the two can be told apart.
+bool ReadQuery(istream& input, SIntVector& start, SIntVector& end);
+
+//Reads the first query from a coordinate file. Returns false if the file can't be opened or read.
+bool LoadCoordFile(const string& fileName, SIntVector& start, SIntVector& end);
+
+//Writes the path to a file, one "x, y" line per node. Returns false if the file can't be opened.
+bool SavePathFile(const string& fileName, NodeList& path);
+
+//Appends the result of one query of a batch as a line: "id cost length x,y x,y ...". If no path was found, cost is -1 and length is 0.
+void AppendPathRecord(string& record, long long id, int cost, NodeList& path);
+
+//One query from a Moving AI scenario (.scen) file. The coordinates have been converted so that y = 0 is the bottom row, as in the rest of the program.
+struct SScenario
+{
+	int mBucket; //Scenarios are grouped into buckets of similar optimal length.
+	string mMapName; //The map file named by the scenario, relative to the scenario file.
+	int mMapWidth;
+	int mMapHeight;
+	SIntVector mStart;
+	SIntVector mGoal;
+	double mOptimalLength; //The optimal octile length given by the file (straight moves cost 1, diagonal moves cost sqrt 2).
+};
+
+//Reads a Moving AI map (.map) file into the terrain. Returns false if the file can't be opened or isn't a valid map, in which case the terrain is unchanged.
+//'.' and 'G' are clear, 'S' (swamp) is wood, 'W' is water, and '@', 'O' and 'T' (trees) are walls.
+bool LoadMovingAIMap(const string& fileName, TerrainMap& terrain);
+
+//Reads every scenario from a Moving AI scenario (.scen) file. Returns false if the file can't be opened or a line is invalid.
+bool LoadMovingAIScenarios(const string& fileName, vector<SScenario>& scenarios);
@@ -0,0 +1,115 @@
+//Leo Croft
+
+// Movement.h
+// ==========
+//
+// The moves a search may make from a square: north, east, south and west, or those and the diagonals
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include <algorithm>
+#include <cstdlib>
+
+enum EMovement
+{
+	FourWay, //North, east, south and west, as ECompass. Moving onto a square costs its terrain.
+	EightWay //The four compass directions and the four diagonals. Costs are scaled so a diagonal costs about √2 times as much.
+};
+
+//With eight way movement, moving onto a square costs its terrain times one of these. 14/10 is within 1% of √2 and keeps costs whole numbers.
+//Path costs found with eight way movement are in tenths of the four way costs.
+const int ORTHOGONAL_MOVE_SCALE = 10;
+const int DIAGONAL_MOVE_SCALE = 14;
+
+//The change in x and y of each move. The first four are ECompass (north, east, south, west), then north east, south east, south west and north west.
+const int MAX_MOVE_DIRECTIONS = 8;
+const int MOVE_DX[MAX_MOVE_DIRECTIONS] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+const int MOVE_DY[MAX_MOVE_DIRECTIONS] = { 1, 0, -1, 0, 1, -1, -1, 1 };
+
+// Which moves a search may make, and what they cost. The default is four way movement, which every search used before diagonals were added.
+// Every move is reversible and costs the same both ways except for the terrain of the square moved onto, so a search can run backwards using
+// the same rules.
+struct SMovementRules
+{
+	EMovement mMovement = EMovement::FourWay;
+
+	//If false, a diagonal move is only allowed when both of the squares it passes between are open, so paths never clip the corner of a wall.
+	//Diagonal moves then never join squares that four way moves can't, so the map's component index still applies.
+	bool mCutCorners = false;
+
+	//The number of entries of MOVE_DX and MOVE_DY a search should try.
+	int NumDirections() const
+	{
+		return (mMovement == EMovement::EightWay) ? MAX_MOVE_DIRECTIONS : ECompass::West + 1;
+	}
+
+	//The index of the square one move in the direction from a square. The map is surrounded by walls, so it is never off the map from an open square.
+	static int Offset(const TerrainMap& terrain, int direction)
+	{
+		return MOVE_DY[direction] * terrain.GetStride() + MOVE_DX[direction];
+	}
+
+	//True if the move in the direction from the square at index is allowed. The same move in the other direction is allowed too.
+	bool CanMove(const TerrainMap& terrain, int index, int direction) const
+	{
+		if (terrain[index + Offset(terrain, direction)] == ENodeType::wall)
+		{
+			return false;
+		}
+		if (direction <= ECompass::West || mCutCorners)
+		{
+			return true;
+		}
+		return terrain[index + MOVE_DX[direction]] != ENodeType::wall && terrain[index + MOVE_DY[direction] * terrain.GetStride()] != ENodeType::wall;
+	}
+
+	//The cost of a move in the direction onto the square at target.
+	int MoveCost(const TerrainMap& terrain, int target, int direction) const
+	{
+		if (mMovement == EMovement::FourWay)
+		{
+			return int(terrain[target]);
+		}
+		return int(terrain[target]) * ((direction <= ECompass::West) ? ORTHOGONAL_MOVE_SCALE : DIAGONAL_MOVE_SCALE);
+	}
+
+	//The cost of the shortest route across the given distances on clear terrain: Manhattan distance for four way movement, octile distance for eight way.
+	//Terrain costs at least 1, so it never overestimates the cost of a route.
+	int Distance(int dx, int dy) const
+	{
+		dx = abs(dx);
+		dy = abs(dy);
+		if (mMovement == EMovement::FourWay)
+		{
+			return dx + dy;
+		}
+		return ORTHOGONAL_MOVE_SCALE * max(dx, dy) + (DIAGONAL_MOVE_SCALE - ORTHOGONAL_MOVE_SCALE) * min(dx, dy);
+	}
+
+	//The map's component index (see CTerrainMap::CanReach), if it applies to these rules. Cutting corners joins squares the index
+	//counts as apart, so then every square is assumed to be reachable and the search finds out for itself.
+	bool CanReach(const TerrainMap& terrain, int startIndex, int goalIndex) const
+	{
+		if (mMovement == EMovement::EightWay && mCutCorners)
+		{
+			return true;
+		}
+		return terrain.CanReach(startIndex, goalIndex);
+	}
+
+	//The direction of the move that changes x and y by the given amounts, or -1 if no single move does.
+	int Direction(int dx, int dy) const
+	{
+		for (int direction = 0; direction < NumDirections(); direction++)
+		{
+			if (MOVE_DX[direction] == dx && MOVE_DY[direction] == dy)
+			{
+				return direction;
+			}
+		}
+		return -1;
+	}
+};
@@ -0,0 +1,207 @@
+//Leo Croft
+
+// NodePool.cpp
+// ============
+//
+// Implementation of the SNode pool allocator
+//
+
+#include "NodePool.h" // Declaration of this class
+#include <mutex>
+#include <new>
+
+//A free node is used to hold the link to the next free node.
+struct SFreeNode
+{
+	SFreeNode* mpNext;
+};
+
+//Free nodes given up by threads that have exited or were holding too many.
+static mutex gSharedFreeListLock;
+static SFreeNode* gpSharedFreeList = nullptr;
+static SFreeNode* gpSharedFreeTail = nullptr;
+static long long gSharedFreeCount = 0;
+
+//The free list and counters of one thread.
+struct SNodePoolThreadData
+{
+	SFreeNode* mpFreeList = nullptr;
+	SFreeNode* mpFreeTail = nullptr; //The last node on the free list, so the whole list can be given away without walking it.
+	long long mFreeCount = 0;
+	SNodePoolCounters mCounters;
+
+	//When the thread exits, give its free nodes to the shared list so their memory can be reused.
+	~SNodePoolThreadData()
+	{
+		GiveToShared();
+	}
+
+	//Adds the count nodes linked from first to last onto the shared list.
+	static void AddToShared(SFreeNode* first, SFreeNode* last, long long count)
+	{
+		lock_guard<mutex> lock(gSharedFreeListLock);
+		last->mpNext = gpSharedFreeList;
+		if (gpSharedFreeList == nullptr)
+		{
+			gpSharedFreeTail = last;
+		}
+		gpSharedFreeList = first;
+		gSharedFreeCount += count;
+	}
+
+	//Moves every node on the free list onto the shared list.
+	void GiveToShared()
+	{
+		if (mpFreeList == nullptr)
+		{
+			return;
+		}
+
+		AddToShared(mpFreeList, mpFreeTail, mFreeCount);
+		mpFreeList = nullptr;
+		mpFreeTail = nullptr;
+		mFreeCount = 0;
+	}
+
+	//Keeps the first keepCount nodes on the free list and moves the rest onto the shared list.
+	//The first nodes were freed most recently, so they are the most likely to still be in the cache.
+	void GiveExcessToShared(long long keepCount)
+	{
+		if (mFreeCount <= keepCount)
+		{
+			return;
+		}
+		if (keepCount == 0)
+		{
+			GiveToShared();
+			return;
+		}
+
+		//Find the split outside the lock.
+		SFreeNode* lastKept = mpFreeList;
+		for (long long i = 1; i < keepCount; i++)
+		{
+			lastKept = lastKept->mpNext;
+		}
+		AddToShared(lastKept->mpNext, mpFreeTail, mFreeCount - keepCount);
+		lastKept->mpNext = nullptr;
+		mpFreeTail = lastKept;
+		mFreeCount = keepCount;
+	}
+
+	//Refills the empty free list, first with up to a block's worth of nodes from the shared list and otherwise with a new block from the heap.
+	void Refill()
+	{
+		{
+			lock_guard<mutex> lock(gSharedFreeListLock);
+			if (gpSharedFreeList != nullptr)
+			{
+				mpFreeList = gpSharedFreeList;
+				mpFreeTail = gpSharedFreeList;
+				mFreeCount = 1;
+				while (mFreeCount < NODE_POOL_BLOCK_SIZE && mpFreeTail->mpNext != nullptr)
+				{
+					mpFreeTail = mpFreeTail->mpNext;
+					mFreeCount++;
+				}
+
+				gpSharedFreeList = mpFreeTail->mpNext;
+				if (gpSharedFreeList == nullptr)
+				{
+					gpSharedFreeTail = nullptr;
+				}
+				gSharedFreeCount -= mFreeCount;
+				mpFreeTail->mpNext = nullptr;
+				return;
+			}
+		}
+
+		const size_t nodeSize = (sizeof(SNode) > sizeof(SFreeNode)) ? sizeof(SNode) : sizeof(SFreeNode);
+		char* block = static_cast<char*>(::operator new(nodeSize * NODE_POOL_BLOCK_SIZE));
+		mCounters.mHeapAllocations++;
+
+		//Link the nodes of the block together, in order, so they are handed out contiguously.
+		mpFreeTail = reinterpret_cast<SFreeNode*>(block + (NODE_POOL_BLOCK_SIZE - 1) * nodeSize);
+		for (int i = NODE_POOL_BLOCK_SIZE - 1; i >= 0; i--)
+		{
+			SFreeNode* node = reinterpret_cast<SFreeNode*>(block + i * nodeSize);
+			node->mpNext = mpFreeList;
+			mpFreeList = node;
+		}
+		mFreeCount = NODE_POOL_BLOCK_SIZE;
+	}
+};
+
+static thread_local SNodePoolThreadData tPoolData;
+
+//Returns memory for one SNode.
+void* CNodePool::Allocate()
+{
+	if (tPoolData.mpFreeList == nullptr)
+	{
+		tPoolData.Refill();
+	}
+
+	SFreeNode* node = tPoolData.mpFreeList;
+	tPoolData.mpFreeList = node->mpNext;
+	tPoolData.mFreeCount--;
+	if (tPoolData.mpFreeList == nullptr)
+	{
+		tPoolData.mpFreeTail = nullptr;
+	}
+
+	tPoolData.mCounters.mNodesAllocated++;
+	tPoolData.mCounters.mLiveNodes++;
+	if (tPoolData.mCounters.mLiveNodes > tPoolData.mCounters.mPeakLiveNodes)
+	{
+		tPoolData.mCounters.mPeakLiveNodes = tPoolData.mCounters.mLiveNodes;
+	}
+	return node;
+}
+
+//Returns the memory of an SNode to the pool.
+void CNodePool::Free(void* node)
+{
+	if (node == nullptr)
+	{
+		return;
+	}
+
+	SFreeNode* freeNode = static_cast<SFreeNode*>(node);
+	freeNode->mpNext = tPoolData.mpFreeList;
+	if (tPoolData.mpFreeList == nullptr)
+	{
+		tPoolData.mpFreeTail = freeNode;
+	}
+	tPoolData.mpFreeList = freeNode;
+	tPoolData.mFreeCount++;
+	tPoolData.mCounters.mLiveNodes--;
+
+	if (tPoolData.mFreeCount > NODE_POOL_MAX_FREE_NODES)
+	{
+		tPoolData.GiveExcessToShared(NODE_POOL_KEEP_FREE_NODES);
+	}
+}
+
+//The counters for the calling thread.
+SNodePoolCounters CNodePool::GetCounters()
+{
+	return tPoolData.mCounters;
+}
+
+//Sets the peak number of live nodes for the calling thread to the current number.
+void CNodePool::ResetPeak()
+{
+	tPoolData.mCounters.mPeakLiveNodes = tPoolData.mCounters.mLiveNodes;
+}
+
+// SNode allocation is routed through the pool.
+void* SNode::operator new(size_t size)
+{
+	return CNodePool::Allocate();
+}
+
+void SNode::operator delete(void* node)
+{
+	CNodePool::Free(node);
+}
@@ -0,0 +1,48 @@
+//Leo Croft
+
+// NodePool.h
+// ==========
+//
+// Pool allocator for SNode. The searches create and destroy a node for every square they visit,
+// so SNode's operator new and delete are routed here instead of the heap.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+
+const int NODE_POOL_BLOCK_SIZE = 4096; //The number of nodes in each block taken from the heap.
+const int NODE_POOL_MAX_FREE_NODES = NODE_POOL_BLOCK_SIZE * 64; //A thread holding more free nodes than this gives some to the shared list.
+const int NODE_POOL_KEEP_FREE_NODES = NODE_POOL_MAX_FREE_NODES / 2; //The free nodes it keeps, so it can allocate again without locking.
+
+//Counters for the pool, kept separately for each thread.
+struct SNodePoolCounters
+{
+	long long mHeapAllocations = 0; //Number of blocks this thread has taken from the heap. Stays the same once the pool has warmed up.
+	long long mNodesAllocated = 0; //Number of nodes handed out.
+	long long mLiveNodes = 0; //Nodes allocated by this thread minus nodes freed by this thread.
+	long long mPeakLiveNodes = 0; //Highest value of mLiveNodes since the last call to ResetPeak.
+};
+
+// Nodes are handed out from contiguous blocks of NODE_POOL_BLOCK_SIZE nodes, and freed nodes are kept on a free list to be handed out again.
+// Each thread has its own free list, so no locking is needed to allocate or free a node. A node may be freed on a different thread to
+// the one that allocated it (EG, a path passed back from a worker thread); It is simply added to the free list of the thread that frees it.
+// Blocks are never returned to the heap. When a thread exits its free nodes are given to a shared list, and when its free list grows past
+// NODE_POOL_MAX_FREE_NODES every node over NODE_POOL_KEEP_FREE_NODES is. This stops nodes building up on a thread that frees more than it
+// allocates. A thread with no free nodes takes up to a block's worth from the shared list before going to the heap. Moving nodes in these
+// amounts means a thread that allocates and frees a large search's worth of nodes doesn't lock on every few allocations.
+class CNodePool
+{
+public:
+	//Returns memory for one SNode.
+	static void* Allocate();
+
+	//Returns the memory of an SNode to the pool.
+	static void Free(void* node);
+
+	//The counters for the calling thread.
+	static SNodePoolCounters GetCounters();
+
+	//Sets the peak number of live nodes for the calling thread to the current number.
+	static void ResetPeak();
+};
@@ -0,0 +1,189 @@
+//Leo Croft
+
+// PathCache.cpp
+// =============
+//
+// Implementation of the path cache
+//
+
+#include "PathCache.h" // Declaration of this class
+
+//The memory used by an entry besides its path: The entry, its list links and its place in the index.
+const size_t PATH_CACHE_ENTRY_OVERHEAD = 96;
+
+bool CPathCache::SKey::operator==(const SKey& other) const
+{
+	return mMapId == other.mMapId && mMapVersion == other.mMapVersion && mStart.x == other.mStart.x && mStart.y == other.mStart.y &&
+		mGoal.x == other.mGoal.x && mGoal.y == other.mGoal.y && mSearchType == other.mSearchType && mMovement == other.mMovement &&
+		mCutCorners == other.mCutCorners;
+}
+
+size_t CPathCache::SKeyHash::operator()(const SKey& key) const
+{
+	//Combine the fields with a multiplicative hash.
+	size_t hash = key.mMapId;
+	const int values[] = { int(key.mMapVersion), key.mStart.x, key.mStart.y, key.mGoal.x, key.mGoal.y, int(key.mSearchType),
+		int(key.mMovement) * 2 + int(key.mCutCorners) };
+	for (int i = 0; i < 7; i++)
+	{
+		hash = (hash ^ unsigned(values[i])) * 0x9E3779B97F4A7C15ull;
+	}
+	return hash ^ (hash >> 32);
+}
+
+CPathCache::CPathCache(size_t maxBytes) : mMaxBytes(maxBytes)
+{
+}
+
+//Returns the cached path if there is one, and otherwise runs the search and caches the result.
+bool CPathCache::FindPath(ISearch& search, ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, NodeList& path,
+	const SMovementRules& movement)
+{
+	bool found;
+	if (Lookup(searchType, terrain, start, goal, found, path, movement))
+	{
+		return found;
+	}
+
+	unique_ptr<SNode> startNode(new SNode{ start.x, start.y, 0 });
+	unique_ptr<SNode> goalNode(new SNode{ goal.x, goal.y, 0 });
+	found = search.FindPath(terrain, move(startNode), move(goalNode), path);
+	if (!found)
+	{
+		path.clear(); //Some searches leave bookkeeping nodes in the path when they fail.
+	}
+	Store(searchType, terrain, start, goal, found, path, movement);
+	return found;
+}
+
+//Looks up a path without searching.
+bool CPathCache::Lookup(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, bool& found, NodeList& path,
+	const SMovementRules& movement)
+{
+	lock_guard<mutex> lock(mLock);
+	CheckMapVersion(terrain);
+
+	auto it = mIndex.find(SKey{ terrain.GetId(), terrain.GetVersion(), start, goal, searchType, movement.mMovement, movement.mCutCorners });
+	if (it == mIndex.end())
+	{
+		mCounters.mMisses++;
+		return false;
+	}
+
+	//Move the entry to the front, as it is now the most recently used.
+	mEntries.splice(mEntries.begin(), mEntries, it->second);
+	mCounters.mHits++;
+
+	SEntry& entry = *it->second;
+	found = entry.mFound;
+	for (auto square = entry.mPath.begin(); square != entry.mPath.end(); square++)
+	{
+		path.push_back(unique_ptr<SNode>(new SNode{ square->x, square->y, 0 }));
+	}
+	return true;
+}
+
+//Adds the result of a search to the cache, evicting the least recently used entries to stay under the memory cap.
+void CPathCache::Store(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, bool found, const NodeList& path,
+	const SMovementRules& movement)
+{
+	SEntry entry;
+	entry.mKey = SKey{ terrain.GetId(), terrain.GetVersion(), start, goal, searchType, movement.mMovement, movement.mCutCorners };
+	entry.mFound = found;
+	entry.mPath.reserve(path.size());
+	for (auto it = path.begin(); it != path.end(); it++)
+	{
+		entry.mPath.push_back({ (*it)->x, (*it)->y });
+	}
+	entry.mBytes = PATH_CACHE_ENTRY_OVERHEAD + entry.mPath.capacity() * sizeof(SIntVector);
+
+	lock_guard<mutex> lock(mLock);
+	CheckMapVersion(terrain);
+
+	//Another thread may have stored the same path while this one was searching.
+	auto existing = mIndex.find(entry.mKey);
+	if (existing != mIndex.end())
+	{
+		Remove(existing->second);
+	}
+
+	if (entry.mBytes > mMaxBytes)
+	{
+		return; //Would never fit.
+	}
+
+	while (mCounters.mBytes + entry.mBytes > mMaxBytes)
+	{
+		Remove(prev(mEntries.end()));
+		mCounters.mEvictions++;
+	}
+
+	mCounters.mBytes += entry.mBytes;
+	mCounters.mEntries++;
+	mEntries.push_front(move(entry));
+	mIndex[mEntries.front().mKey] = mEntries.begin();
+}
+
+//Changes the memory cap, evicting entries if needed.
+void CPathCache::SetMaxBytes(size_t maxBytes)
+{
+	lock_guard<mutex> lock(mLock);
+	mMaxBytes = maxBytes;
+	while (size_t(mCounters.mBytes) > mMaxBytes)
+	{
+		Remove(prev(mEntries.end()));
+		mCounters.mEvictions++;
+	}
+}
+
+void CPathCache::Clear()
+{
+	lock_guard<mutex> lock(mLock);
+	mEntries.clear();
+	mIndex.clear();
+	mMapVersions.clear();
+	mCounters = SPathCacheCounters();
+}
+
+SPathCacheCounters CPathCache::GetCounters() const
+{
+	lock_guard<mutex> lock(mLock);
+	return mCounters;
+}
+
+//Removes the entry, keeping the counters up to date. The lock must be held.
+void CPathCache::Remove(list<SEntry>::iterator entry)
+{
+	mCounters.mBytes -= entry->mBytes;
+	mCounters.mEntries--;
+	mIndex.erase(entry->mKey);
+	mEntries.erase(entry);
+}
+
+//Removes the entries for older versions of the map if this version hasn't been seen before. The lock must be held.
+void CPathCache::CheckMapVersion(const TerrainMap& terrain)
+{
+	auto seen = mMapVersions.find(terrain.GetId());
+	if (seen == mMapVersions.end())
+	{
+		mMapVersions[terrain.GetId()] = terrain.GetVersion();
+		return;
+	}
+	if (seen->second == terrain.GetVersion())
+	{
+		return;
+	}
+
+	//The map has changed, so none of its old paths can be used again.
+	seen->second = terrain.GetVersion();
+	for (auto it = mEntries.begin(); it != mEntries.end();)
+	{
+		auto next = std::next(it);
+		if (it->mKey.mMapId == terrain.GetId() && it->mKey.mMapVersion != terrain.GetVersion())
+		{
+			Remove(it);
+			mCounters.mInvalidations++;
+		}
+		it = next;
+	}
+}
@@ -0,0 +1,98 @@
+//Leo Croft
+
+// PathCache.h
+// ===========
+//
+// Least recently used cache of paths, placed in front of the searches so repeated queries don't search again
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "SearchFactory.h" // Search classes
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+const size_t PATH_CACHE_DEFAULT_BYTES = 64 * 1024 * 1024;
+
+//Counters for sizing the cache.
+struct SPathCacheCounters
+{
+	long long mHits = 0;
+	long long mMisses = 0;
+	long long mEvictions = 0; //Entries removed to keep the cache under its memory cap.
+	long long mInvalidations = 0; //Entries removed because the map they were found on has changed.
+	long long mEntries = 0;
+	long long mBytes = 0; //Estimated memory used by the entries.
+};
+
+// Paths are keyed by the map's id and version, the start and goal, the search type and the movement rules. Editing a map changes its version,
+// so old paths are never returned; The first time the cache sees a new version of a map, it removes every entry for the old versions.
+// Failed searches are cached too. All functions are safe to call from several threads at once. The searches themselves run outside the lock.
+class CPathCache
+{
+private:
+	struct SKey
+	{
+		unsigned int mMapId;
+		unsigned int mMapVersion;
+		SIntVector mStart;
+		SIntVector mGoal;
+		ESearchType mSearchType;
+		EMovement mMovement; //A path found with one set of movement rules may not be allowed, or the cheapest, under another.
+		bool mCutCorners;
+
+		bool operator==(const SKey& other) const;
+	};
+
+	struct SKeyHash
+	{
+		size_t operator()(const SKey& key) const;
+	};
+
+	struct SEntry
+	{
+		SKey mKey;
+		bool mFound;
+		vector<SIntVector> mPath; //Stored as coordinates rather than nodes, which is about a third of the size.
+		size_t mBytes; //Estimated memory used by the entry, including the list and index.
+	};
+
+	list<SEntry> mEntries; //Most recently used at the front.
+	unordered_map<SKey, list<SEntry>::iterator, SKeyHash> mIndex;
+	unordered_map<unsigned int, unsigned int> mMapVersions; //The newest version of each map seen by the cache.
+	size_t mMaxBytes;
+	SPathCacheCounters mCounters;
+	mutable mutex mLock;
+
+	//Removes the entry, keeping the counters up to date. The lock must be held.
+	void Remove(list<SEntry>::iterator entry);
+
+	//Removes the entries for older versions of the map if this version hasn't been seen before. The lock must be held.
+	void CheckMapVersion(const TerrainMap& terrain);
+
+public:
+	CPathCache(size_t maxBytes = PATH_CACHE_DEFAULT_BYTES);
+
+	//Returns the cached path if there is one, and otherwise runs the search and caches the result.
+	//The path is given in the same form as ISearch::FindPath. The movement rules must be the ones the search was made with.
+	bool FindPath(ISearch& search, ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, NodeList& path,
+		const SMovementRules& movement = SMovementRules());
+
+	//Looks up a path without searching. Returns false if it isn't cached; Otherwise sets found, and the path if one was found.
+	bool Lookup(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, bool& found, NodeList& path,
+		const SMovementRules& movement = SMovementRules());
+
+	//Adds the result of a search to the cache, evicting the least recently used entries to stay under the memory cap.
+	void Store(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal, bool found, const NodeList& path,
+		const SMovementRules& movement = SMovementRules());
+
+	//Changes the memory cap, evicting entries if needed.
+	void SetMaxBytes(size_t maxBytes);
+
+	//Removes every entry and resets all of the counters, so the hit rate afterwards is measured from a fresh start.
+	void Clear();
+
+	SPathCacheCounters GetCounters() const;
+};
@@ -0,0 +1,95 @@
+//Leo Croft
+
+// PathService.cpp
+// ===============
+//
+// Implementation of the background path request service
+//
+
+#include "PathService.h" // Declaration of this class
+
+CPathRequest::CPathRequest(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal) :
+	mSearchType(searchType), mpTerrain(&terrain), mStart(start), mGoal(goal), mState(EPathRequestState::REQUEST_QUEUED), mCancelled(false)
+{
+}
+
+//Called by the worker when it has finished with the request.
+void CPathRequest::Finish(EPathRequestState state)
+{
+	//Set under the lock, so a thread in Wait can't miss the notify.
+	{
+		lock_guard<mutex> lock(mDoneLock);
+		mState = state;
+	}
+	mDone.notify_all();
+}
+
+//Blocks until the request is done.
+void CPathRequest::Wait()
+{
+	unique_lock<mutex> lock(mDoneLock);
+	mDone.wait(lock, [this] { return Done(); });
+}
+
+CPathService::CPathService(int numThreads, const CLandmarks* landmarks, const SMovementRules& movement) : mpLandmarks(landmarks), mMovement(movement),
+	mStopping(false), mPool(numThreads)
+{
+	mSearches.resize(mPool.GetNumThreads());
+	for (auto it = mSearches.begin(); it != mSearches.end(); it++)
+	{
+		(*it).resize(ESearchType::NumOfSearches);
+	}
+}
+
+//The pool finishes every task that was submitted, so the requests still queued are cancelled first to let it stop quickly.
+CPathService::~CPathService()
+{
+	mStopping = true;
+}
+
+//Queues a search for a path from start to goal, and returns straight away.
+PathRequestHandle CPathService::Submit(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal)
+{
+	PathRequestHandle request(new CPathRequest(searchType, terrain, start, goal));
+
+	//The task holds its own handle, so the request outlives the caller dropping theirs.
+	mPool.Submit([this, request](int worker)
+	{
+		RunRequest(worker, *request);
+	});
+	return request;
+}
+
+//Runs one request on the given worker.
+void CPathService::RunRequest(int worker, CPathRequest& request)
+{
+	if (request.mCancelled || mStopping)
+	{
+		request.Finish(EPathRequestState::REQUEST_CANCELLED);
+		return;
+	}
+	request.mState = EPathRequestState::REQUEST_RUNNING;
+
+	unique_ptr<ISearch>& search = mSearches[worker][request.mSearchType];
+	if (!search)
+	{
+		search.reset(NewSearch(request.mSearchType, mpLandmarks, mMovement));
+	}
+
+	//The search runs a few steps at a time, so a cancelled request is noticed part way through.
+	CSearchContext context;
+	context.Start(*search, *request.mpTerrain, request.mStart, request.mGoal);
+	EStepPathResults result;
+	while ((result = context.Run(PATH_SERVICE_CANCEL_INTERVAL)) == EStepPathResults::STEP_SUCCESS)
+	{
+		if (request.mCancelled || mStopping)
+		{
+			request.Finish(EPathRequestState::REQUEST_CANCELLED);
+			return;
+		}
+	}
+
+	request.mPath = move(context.GetPath());
+	request.mStats = context.GetStats();
+	request.Finish((result == EStepPathResults::PATH_FOUND) ? EPathRequestState::REQUEST_FOUND : EPathRequestState::REQUEST_NOT_FOUND);
+}
@@ -0,0 +1,120 @@
+//Leo Croft
+
+// PathService.h
+// =============
+//
+// Runs path requests on background threads, so the caller never waits for a search
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "SearchFactory.h" // Search classes
+#include "SearchContext.h" // Searches that can be stopped part way
+#include "ThreadPool.h" // Worker threads
+#include <memory>
+
+//The number of steps a worker runs between checks for cancellation. A step of A* takes well under a microsecond, so a cancelled
+//search stops within a few microseconds.
+const int PATH_SERVICE_CANCEL_INTERVAL = 256;
+
+enum EPathRequestState
+{
+	REQUEST_QUEUED = 0, //Waiting for a worker.
+	REQUEST_RUNNING = 1, //A worker is searching.
+	REQUEST_FOUND = 2, //Finished, and the path is ready.
+	REQUEST_NOT_FOUND = 3, //Finished, and there is no path.
+	REQUEST_CANCELLED = 4 //Stopped before it finished. There is no path.
+};
+
+// One request made to a CPathService. The service and the caller share it, so it stays valid for as long as the caller holds the handle.
+// Poll it with GetState or Done from the game loop. Once Done returns true, the worker has finished with it and the path can be read.
+class CPathRequest
+{
+	friend class CPathService;
+
+private:
+	ESearchType mSearchType;
+	const TerrainMap* mpTerrain;
+	SIntVector mStart;
+	SIntVector mGoal;
+
+	atomic<int> mState; //An EPathRequestState. The path and statistics are written before the state changes to a finished state.
+	atomic<bool> mCancelled;
+	NodeList mPath;
+	SSearchStats mStats;
+
+	mutex mDoneLock; //Guards waiting for the request to finish.
+	condition_variable mDone;
+
+	//Called by the worker when it has finished with the request.
+	void Finish(EPathRequestState state);
+
+public:
+	CPathRequest(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal);
+
+	EPathRequestState GetState() const
+	{
+		return EPathRequestState(mState.load());
+	}
+
+	//True once the request has been found, not found or cancelled. The worker no longer uses the request or the terrain.
+	bool Done() const
+	{
+		return GetState() >= EPathRequestState::REQUEST_FOUND;
+	}
+
+	//Asks the worker to stop. A queued request is never searched, and a running one stops within PATH_SERVICE_CANCEL_INTERVAL steps.
+	//D* Lite and the abstract search of HPA* run whole in their first step, so they can only be stopped before or after it.
+	//A request that has already finished keeps its result.
+	void Cancel()
+	{
+		mCancelled = true;
+	}
+
+	//Blocks until the request is done. Cancel first if the result isn't wanted, so the wait is short.
+	void Wait();
+
+	//The path, once the state is REQUEST_FOUND. It can be moved out.
+	NodeList& GetPath()
+	{
+		return mPath;
+	}
+
+	//The statistics of the search, once the state is REQUEST_FOUND or REQUEST_NOT_FOUND.
+	const SSearchStats& GetStats() const
+	{
+		return mStats;
+	}
+};
+
+using PathRequestHandle = shared_ptr<CPathRequest>;
+
+// Each worker of the pool keeps one search object of each type it has been asked for, so scratch state is never shared between threads.
+// The terrain given to Submit is only read, but must not be changed or destroyed until the request is done. To change the map, cancel
+// the requests on it and wait for them.
+class CPathService
+{
+private:
+	const CLandmarks* mpLandmarks;
+	SMovementRules mMovement;
+	vector<vector<unique_ptr<ISearch>>> mSearches; //[worker][search type]. Created the first time a worker runs a type.
+	atomic<bool> mStopping;
+
+	//Declared last, so the workers are stopped before the searches they use are destroyed.
+	CThreadPool mPool;
+
+	//Runs one request on the given worker.
+	void RunRequest(int worker, CPathRequest& request);
+
+public:
+	//Starts the worker threads. 0 uses one thread per hardware thread. The landmarks, if given, are used by the A* searches.
+	//Every search follows the movement rules; See NewSearch.
+	CPathService(int numThreads = 0, const CLandmarks* landmarks = nullptr, const SMovementRules& movement = SMovementRules());
+
+	//Cancels the requests that haven't finished, and waits for the workers to stop.
+	~CPathService();
+
+	//Queues a search for a path from start to goal, and returns straight away.
+	PathRequestHandle Submit(ESearchType searchType, const TerrainMap& terrain, SIntVector start, SIntVector goal);
+};
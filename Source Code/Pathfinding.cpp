@@ -49,7 +49,9 @@ void main()
 	SIntVector nodeSelectionPos; //Used to allow the user to select start / end positions.
 	IModel* nodeSelectionModel = myEngine->LoadMesh(GRID_SPACE_MESH)->CreateModel(0.0f, SPAWN_Y, 0.0f);
 	float delayTimer = 0.0f; //Track the passage of time between particular calls. EG, steps in single-step pathing.
-	NodeList path;
+	CSearchContext searchContext; //The search being shown a step at a time.
+	CPathService pathService(1); //Only one search is run at a time, so one worker is enough.
+	PathRequestHandle pathRequest; //The search started with Find Path, until its result has been shown.
 
 	/*Declaring and instantiating variables that affect how objects and the camera
 	in the program move.*/
@@ -66,6 +68,26 @@ void main()
 
 		myEngine->DrawScene();
 		frameTime = myEngine->Timer();
+
+		//A search started with Find Path carries on in the background while the menu is used. Its result is shown once it arrives,
+		//unless the user is part way through choosing something.
+		if (pathRequest && pathRequest->Done() && (state == EGameState::Finding || state == EGameState::Setup))
+		{
+			if (pathRequest->GetState() == EPathRequestState::REQUEST_FOUND)
+			{
+				state = EGameState::Pathing;
+				map->SaveResultsToFile(pathRequest->GetPath());
+				cout << SEARCH_COUNT_OUTPUT << pathRequest->GetStats().mNodesExpanded << endl;
+				ball->SetPath(pathRequest->GetPath(), map.get());
+				ball->SpawnBall();
+				ball->SetModelMatrix();
+			}
+			else if (pathRequest->GetState() == EPathRequestState::REQUEST_NOT_FOUND)
+			{
+				state = EGameState::SearchFail;
+			}
+			pathRequest.reset();
+		}
 		
 		if (state == EGameState::ChoosingMap)
 		{
@@ -74,24 +96,12 @@ void main()
 		}
 		else if (state == EGameState::Finding)
 		{
-			//These unique pointers are defined locally because, when they are moved, they are removed from their original position.
-			unique_ptr<SNode> start(new SNode{ map->GetStartNode().x, map->GetStartNode().y, 0 });
-			map->mpGoal.reset(new SNode{ map->GetEndNode().x, map->GetEndNode().y, 1 });
-			path.clear(); //Empty the path of existing nodes to prevent multiple-inclusion of nodes.
-
-			if (pathFinder->FindPath(map->mMapData, move(start), move(map->mpGoal), path))
-			{
-				//cout << "Testing if the unique pointers for start and goal are empty after FindPath call."; //They were
-				state = EGameState::Pathing;
-				map->SaveResultsToFile(path);
-				if (map->GetSearchSelection() == ESearchType::AStar) cout << ASTAR_SEARCH_COUNT_OUTPUT << path.back()->mScore << endl;
-				ball->SetPath(path, map.get());
-				ball->SpawnBall();
-				ball->SetModelMatrix();
-			}
-			else
+			//The search runs on a worker thread, so the scene keeps drawing while it runs. Its result is picked up above.
+			//Press the select button to use the menu while it carries on.
+			textSelectionOutput = SEARCH_RUNNING;
+			if (myEngine->KeyHit(SELECT))
 			{
-				state = EGameState::SearchFail;
+				state = EGameState::Setup;
 			}
 		}
 		else if (state == EGameState::StepFind)
@@ -100,18 +110,17 @@ void main()
 			if (delayTimer <= 0)
 			{
 				delayTimer = STEP_TIMER;
-				//These unique pointers are defined locally because, when they are moved, they are removed from their original position.
-				switch (pathFinder->StepPath(map->mMapData, map->mOpenList, map->mClosedList, map->mpGoal, path))
+				switch (searchContext.Run(1))
 				{
 					// After each step, 
 				case EStepPathResults::STEP_SUCCESS: //If the search was successful, but the goal wasn't found, display the closed and open lists.
-					map->SetupSearchDemo();
+					map->SetupSearchDemo(searchContext.GetOpenList(), searchContext.GetClosedList());
 					break;
 				case EStepPathResults::PATH_FOUND: //If the goal was found, demonstrate the pathing.
 					state = EGameState::Pathing;
-					map->SaveResultsToFile(path);
-					if (map->GetSearchSelection() == ESearchType::AStar) cout << ASTAR_SEARCH_COUNT_OUTPUT << path.back()->mScore << endl;
-					ball->SetPath(path, map.get());
+					map->SaveResultsToFile(searchContext.GetPath());
+					cout << SEARCH_COUNT_OUTPUT << searchContext.GetStats().mNodesExpanded << endl;
+					ball->SetPath(searchContext.GetPath(), map.get());
 					ball->SpawnBall();
 					ball->SetModelMatrix();
 					break;
@@ -213,6 +222,13 @@ void main()
 				switch (optionSelected)
 				{
 				case EOptions::ChooseMap: //If the user selects to choose a map, call in the ReadMap function
+					//The search in the background reads the map, so it has to stop before the map is replaced.
+					if (pathRequest)
+					{
+						pathRequest->Cancel();
+						pathRequest->Wait();
+						pathRequest.reset();
+					}
 					state = EGameState::ChoosingMap;
 					textSelectionOutput = MAP_INPUT_PROMPT;
 					break;
@@ -231,29 +247,24 @@ void main()
 					nodeSelectionModel->SetPosition(0, MAP_LEVEL_Y + OVERLAY_Y, 0);
 					nodeSelectionModel->SetSkin(END_DOT_DEMO);
 					break;
-				case EOptions::FindPath: //If the user selects to find the path, call the selected pathfinding algorithm.
+				case EOptions::FindPath: //If the user selects to find the path, start the selected pathfinding algorithm in the background.
 					state = EGameState::Finding;
+					if (pathRequest)
+					{
+						pathRequest->Cancel(); //Replaced by the new search.
+					}
+					pathRequest = pathService.Submit(map->GetSearchSelection(), map->mMapData, map->GetStartNode(), map->GetEndNode());
 					break;
 				case EOptions::StepPath: //If the user selects to find the path step by step, 
 					state = EGameState::StepFind;
-					
-					//The following steps are done here because the StepFind gamestate is used to track the step-by-step progress.
-					path.clear(); //Empty the path of existing nodes to prevent multiple-inclusion of nodes.
-					
-					if(map->GetSearchSelection() == ESearchType::AStar)	path.push_back(unique_ptr<SNode>(new SNode)); //The score value on this node will be used to track the count.
-
-					//Reset the search lists when the user selects to search step-by-step, to ensure they are empty.
-					map->mOpenList.clear();
-					map->mClosedList.clear();
-					
-					//Add the start node to the openlist for the first call.
-					unique_ptr<SNode> tmp(new SNode{ map->GetStartNode().x, map->GetStartNode().y, 0 });
-					SNode tmpGoal = { map->GetEndNode().x, map->GetEndNode().y };
-					tmp->mScore = tmpGoal.CalculateManhattanDistance(tmp->x, tmp->y);
-					map->mOpenList.push_back(move(tmp));
+					if (pathRequest)
+					{
+						pathRequest->Cancel(); //The stepped search replaces any search in the background.
+						pathRequest.reset();
+					}
 
-					//Set the goal.
-					map->mpGoal.reset(new SNode{ map->GetEndNode().x, map->GetEndNode().y, 1 });					
+					//The context holds the lists, the goal and the path between steps, so it only needs the start and end.
+					searchContext.Start(*pathFinder, map->mMapData, map->GetStartNode(), map->GetEndNode());
 					break;
 				}
 				optionSelected = 0;
@@ -340,6 +351,13 @@ void main()
 				{
 					map->SetEndNode(nodeSelectionPos);
 				}
+
+				//A search still running in the background is for the old start and end, so its result is no longer wanted.
+				if (pathRequest)
+				{
+					pathRequest->Cancel();
+					pathRequest.reset();
+				}
 				state = EGameState::Setup;
 				nodeSelectionModel->SetY(SPAWN_Y);
 			}
@@ -0,0 +1,262 @@
+//Leo Croft
+
+// PathfindingCLI.cpp
+// ==================
+//
+// Command line front end for the searches. Does not use the TL-Engine, so it can run without a display.
+// Loads <name>Map.txt and <name>Coords.txt, runs the chosen search and writes the path in the same format as the TL-Engine program.
+//
+// Usage: PathfindingCLI <map name> [search type] [output file] [--batch] [--threads N] [--cache MB] [--landmarks K] [--deadline MS] [--cluster-size N] [--diagonal] [--cut-corners]
+//   search type - One of SEARCH_TYPE_NAMES (default AStar)
+//   output file - Where to write the path (default output.txt)
+//   --batch     - Answer every query in the coordinate file, in parallel. The output has one record per query,
+//                 "id cost length x,y x,y ...", in the order they finish. See CBatchSearch::StreamPaths
+//   --threads   - The number of worker threads for --batch (default one per hardware thread)
+//   --cache     - Answer repeated queries in --batch from a path cache of this many megabytes
+//   --landmarks - Give the A* searches the ALT heuristic with K landmarks. The tables are loaded from <map name>Map.txt.landmarks
+//                 if it was saved for this map, otherwise they are built and saved there for next time
+//   --deadline  - For ARAStar, stop improving the path this many milliseconds after the search starts (default: until it is the cheapest)
+//   --cluster-size - For HPAStar, the width of the clusters in squares (default HPA_DEFAULT_CLUSTER_SIZE)
+//   --diagonal  - Move in eight directions instead of four. Costs are then in tenths; See Movement.h
+//   --cut-corners - With --diagonal, allow diagonal moves past the corner of a wall
+//
+// Exit code is 0 if a path was found (for every query in batch mode), 1 if there is no path, and 2 if the input was invalid.
+//
+
+#include "SearchFactory.h" // Search classes
+#include "MapLoader.h" // Map file parsing
+#include "BatchSearch.h" // Batch mode
+#include "Landmarks.h" // ALT heuristic
+#include "SearchARAStar.h" // Deadline for the anytime search
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+const int EXIT_PATH_FOUND = 0;
+const int EXIT_NO_PATH = 1;
+const int EXIT_BAD_INPUT = 2;
+const int BATCH_OUTPUT_BUFFER_SIZE = 1 << 20; //Batch output is written through a large buffer, as there may be millions of records.
+
+//Prints how to use the program, including the list of searches.
+void PrintUsage()
+{
+	cerr << "Usage: PathfindingCLI <map name> [search type] [output file] [--batch] [--threads N] [--cache MB] [--landmarks K] [--deadline MS] [--cluster-size N] [--diagonal] [--cut-corners]" << endl;
+	cerr << "Search types:";
+	for (int i = 0; i < ESearchType::NumOfSearches; i++)
+	{
+		cerr << " " << SEARCH_TYPE_NAMES[i];
+	}
+	cerr << endl;
+}
+
+//Answers every query in the coordinate file on a pool of threads, streaming the results to the output file.
+int RunBatch(const TerrainMap& terrain, const string& coordFile, ESearchType searchType, const string& outputFile, int numThreads, int cacheMegabytes,
+	const CLandmarks* landmarks, const SMovementRules& movement, int clusterSize)
+{
+	ifstream input(coordFile);
+	if (!input)
+	{
+		cerr << "Could not read coordinate file " << coordFile << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	//The buffer must be set before the file is opened.
+	vector<char> buffer(BATCH_OUTPUT_BUFFER_SIZE);
+	ofstream output;
+	output.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+	output.open(outputFile);
+	if (!output)
+	{
+		cerr << "Could not write " << outputFile << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	CBatchSearch batch(searchType, numThreads, landmarks, movement, clusterSize);
+	CPathCache cache(size_t(cacheMegabytes) * 1024 * 1024);
+	if (cacheMegabytes > 0)
+	{
+		batch.SetPathCache(&cache);
+	}
+
+	SStreamSummary summary;
+	auto startTime = chrono::steady_clock::now();
+	bool valid = batch.StreamPaths(terrain, input, output, summary);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	output.close();
+
+	cout << SEARCH_TYPE_NAMES[searchType] << ": " << summary.mFound << " of " << summary.mQueries << " queries found a path in " << seconds
+		 << "s on " << batch.GetNumThreads() << " threads, written to " << outputFile << endl;
+	if (cacheMegabytes > 0)
+	{
+		SPathCacheCounters counters = cache.GetCounters();
+		cout << "Path cache: " << counters.mHits << " hits, " << counters.mMisses << " misses, " << counters.mEvictions << " evictions, "
+			 << counters.mEntries << " entries using " << counters.mBytes << " bytes" << endl;
+	}
+	if (!valid)
+	{
+		cerr << "Stopped at an invalid query after query " << summary.mQueries - 1 << " in " << coordFile << endl;
+		return EXIT_BAD_INPUT;
+	}
+	return (summary.mFound == summary.mQueries) ? EXIT_PATH_FOUND : EXIT_NO_PATH;
+}
+
+//Loads the landmark tables saved next to the map file, or builds them and saves them there if there aren't any for this map.
+void PrepareLandmarks(const TerrainMap& terrain, const string& mapFile, int numLandmarks, CLandmarks& landmarks)
+{
+	string landmarkFile = LandmarkFileName(mapFile);
+	if (landmarks.Load(landmarkFile, terrain) && landmarks.GetNumLandmarks() == numLandmarks)
+	{
+		cout << "Loaded " << numLandmarks << " landmarks from " << landmarkFile << endl;
+		return;
+	}
+
+	auto startTime = chrono::steady_clock::now();
+	landmarks.Build(terrain, numLandmarks);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	cout << "Built " << landmarks.GetNumLandmarks() << " landmarks in " << seconds << "s";
+	if (landmarks.Save(landmarkFile))
+	{
+		cout << ", saved to " << landmarkFile;
+	}
+	cout << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	//Split the options from the positional arguments.
+	vector<string> arguments;
+	bool batchMode = false;
+	int numThreads = 0;
+	int cacheMegabytes = 0;
+	int numLandmarks = 0;
+	int deadlineMilliseconds = 0;
+	int clusterSize = 0;
+	SMovementRules movement;
+	for (int i = 1; i < argc; i++)
+	{
+		string argument = argv[i];
+		if (argument == "--batch")
+		{
+			batchMode = true;
+		}
+		else if (argument == "--threads" && i + 1 < argc)
+		{
+			numThreads = atoi(argv[++i]);
+		}
+		else if (argument == "--cache" && i + 1 < argc)
+		{
+			cacheMegabytes = atoi(argv[++i]);
+		}
+		else if (argument == "--landmarks" && i + 1 < argc)
+		{
+			numLandmarks = atoi(argv[++i]);
+		}
+		else if (argument == "--deadline" && i + 1 < argc)
+		{
+			deadlineMilliseconds = atoi(argv[++i]);
+		}
+		else if (argument == "--cluster-size" && i + 1 < argc)
+		{
+			clusterSize = atoi(argv[++i]);
+		}
+		else if (argument == "--diagonal")
+		{
+			movement.mMovement = EMovement::EightWay;
+		}
+		else if (argument == "--cut-corners")
+		{
+			movement.mCutCorners = true;
+		}
+		else
+		{
+			arguments.push_back(argument);
+		}
+	}
+
+	if (arguments.empty())
+	{
+		PrintUsage();
+		return EXIT_BAD_INPUT;
+	}
+
+	string mapName = arguments[0];
+	ESearchType searchType = ESearchType::AStar;
+	string outputFile = PATH_OUTPUT_FILE;
+
+	if (arguments.size() > 1 && !SearchTypeFromName(arguments[1], searchType))
+	{
+		cerr << "Unknown search type: " << arguments[1] << endl;
+		PrintUsage();
+		return EXIT_BAD_INPUT;
+	}
+	if (arguments.size() > 2)
+	{
+		outputFile = arguments[2];
+	}
+
+	TerrainMap terrain;
+	SIntVector startCoords;
+	SIntVector endCoords;
+
+	if (!LoadMapFile(mapName + MAP_FILE_EXTENSION, terrain))
+	{
+		cerr << "Could not read map file " << mapName + MAP_FILE_EXTENSION << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	CLandmarks landmarks;
+	if (numLandmarks > 0)
+	{
+		PrepareLandmarks(terrain, mapName + MAP_FILE_EXTENSION, numLandmarks, landmarks);
+	}
+	//Without landmarks the searches are given none, so the A* searches use the plain kernel rather than checking an empty table at every node.
+	const CLandmarks* landmarkTables = (numLandmarks > 0) ? &landmarks : nullptr;
+
+	if (batchMode)
+	{
+		return RunBatch(terrain, mapName + COORD_FILE_EXTENSION, searchType, outputFile, numThreads, cacheMegabytes, landmarkTables, movement, clusterSize);
+	}
+	if (!LoadCoordFile(mapName + COORD_FILE_EXTENSION, startCoords, endCoords))
+	{
+		cerr << "Could not read coordinate file " << mapName + COORD_FILE_EXTENSION << endl;
+		return EXIT_BAD_INPUT;
+	}
+	if (!terrain.InBounds(startCoords.x, startCoords.y) || !terrain.InBounds(endCoords.x, endCoords.y))
+	{
+		cerr << "Start or end coordinates are outside the map" << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	unique_ptr<ISearch> pathFinder(NewSearch(searchType, landmarkTables, movement, clusterSize));
+	unique_ptr<SNode> start(new SNode{ startCoords.x, startCoords.y, 0 });
+	unique_ptr<SNode> goal(new SNode{ endCoords.x, endCoords.y, 0 });
+	NodeList path;
+
+	if (searchType == ESearchType::ARAStar && deadlineMilliseconds > 0)
+	{
+		static_cast<CSearchARAStar*>(pathFinder.get())->SetDeadline(chrono::steady_clock::now() + chrono::milliseconds(deadlineMilliseconds));
+	}
+
+	if (!pathFinder->FindPath(terrain, move(start), move(goal), path))
+	{
+		cout << "No path found" << endl;
+		return EXIT_NO_PATH;
+	}
+
+	if (!SavePathFile(outputFile, path))
+	{
+		cerr << "Could not write " << outputFile << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	const SSearchStats& stats = pathFinder->GetStats();
+	cout << SEARCH_TYPE_NAMES[searchType] << ": path of " << path.size() << " nodes, cost " << CalculatePathCost(terrain, path, movement)
+		 << ", written to " << outputFile << endl;
+	cout << stats.mNodesExpanded << " nodes expanded, " << stats.mNodesGenerated << " generated, " << stats.mReopenings << " reopened, peak open list "
+		 << stats.mPeakOpenSize << ", " << stats.mMilliseconds << " ms" << endl;
+	if (stats.mEpsilon > 1.0)
+	{
+		cout << "Cost at most " << stats.mEpsilon << " times the cheapest" << endl;
+	}
+	return EXIT_PATH_FOUND;
+}
@@ -0,0 +1,347 @@
+//Leo Croft
+
+// ScenarioRunner.cpp
+// ==================
+//
+// Standalone program (no TL-Engine) that runs every scenario in a Moving AI scenario (.scen) file through each search.
+// Checks every path, and prints latency percentiles for each bucket of the scenario file as CSV or JSON.
+//
+// Usage: ScenarioRunner <scenario file> [options]
+//   --map file.map        Map to use instead of the one named in the scenario file
+//   --searches AStar      Searches from SEARCH_TYPE_NAMES. Defaults to all of them
+//   --format csv|json     Defaults to csv
+//   --movement four|eight|eight-cut  Move in four directions (the default), or eight with or without cutting corners
+//
+// Each scenario is also solved by Dijkstra's algorithm, which gives the cheapest cost on this map under the same movement.
+// A path is counted as failed if it is missing when Dijkstra finds one (or found when it doesn't), broken, cheaper than Dijkstra's,
+// or dearer than the bound the search reports (see SSearchStats::mEpsilon). Searches with no bound, such as HPA* and breadth first,
+// are only counted as suboptimal when their path costs more.
+// The optimal lengths in the scenario files are for octile movement without cutting corners (diagonal moves cost sqrt 2, and every
+// square costs 1). With eight way movement on a map of only clear squares and walls, paths are also checked against them: A diagonal
+// here costs 1.4 rather than sqrt 2, so a path may be up to 1% shorter than the optimal length, but never longer than the bound allows.
+// Otherwise the optimal lengths are only reported, as the mean ratio of cost to optimal length. Eight way costs are in tenths,
+// and are scaled back for the ratio.
+//
+// Exit code is 0 if every scenario passed, 1 if any failed, and 2 if the input was invalid.
+//
+
+#include "SearchFactory.h" // Search classes
+#include "MapLoader.h" // Map file parsing
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <map>
+#include <algorithm>
+#include <cmath>
+
+const int EXIT_ALL_PASSED = 0;
+const int EXIT_SOME_FAILED = 1;
+const int EXIT_BAD_INPUT = 2;
+const double EPSILON_TOLERANCE = 0.0001; //The bounds reported by the searches are rounded.
+const double OPTIMAL_LENGTH_TOLERANCE = 0.001; //The optimal lengths in scenario files are rounded.
+
+//Names for --movement, as used by Benchmark.
+const string MOVEMENT_FOUR_WAY = "four";
+const string MOVEMENT_EIGHT_WAY = "eight";
+const string MOVEMENT_EIGHT_WAY_CUT_CORNERS = "eight-cut";
+
+//The shortest an eight way path can be, as a fraction of its octile length: Every diagonal costs 1.4 instead of sqrt 2.
+const double SHORTEST_OCTILE_RATIO = double(DIAGONAL_MOVE_SCALE) / (ORTHOGONAL_MOVE_SCALE * sqrt(2.0));
+
+//The results of one search over every scenario in a bucket.
+struct SBucketResult
+{
+	int mScenarios = 0;
+	int mFailed = 0;
+	int mSuboptimal = 0; //Paths from searches with no bound on their cost, that cost more than the cheapest.
+	double mTotalRatio = 0.0; //Sum of path cost / optimal length, for the scenarios with a non zero optimal length.
+	int mRatioCount = 0;
+	vector<double> mMicroseconds; //Time taken by each scenario.
+};
+
+//Returns the value below which the given percentage of the sorted times fall.
+double Percentile(const vector<double>& sortedTimes, double percent)
+{
+	if (sortedTimes.empty())
+	{
+		return 0.0;
+	}
+	int index = int(percent / 100.0 * (sortedTimes.size() - 1) + 0.5);
+	return sortedTimes[index];
+}
+
+//Returns the directory part of a file name, including the final separator.
+string DirectoryOf(const string& fileName)
+{
+	size_t separator = fileName.find_last_of("/\\");
+	return (separator == string::npos) ? "" : fileName.substr(0, separator + 1);
+}
+
+//Loads the map named by a scenario. Scenario files name maps relative to themselves, sometimes with a directory in front.
+bool LoadScenarioMap(const string& scenarioFile, const string& mapName, TerrainMap& terrain)
+{
+	string directory = DirectoryOf(scenarioFile);
+	if (LoadMovingAIMap(directory + mapName, terrain))
+	{
+		return true;
+	}
+	size_t separator = mapName.find_last_of("/\\");
+	return separator != string::npos && LoadMovingAIMap(directory + mapName.substr(separator + 1), terrain);
+}
+
+//True if every square on the map is clear or a wall, so path costs are lengths, as they are in scenario files.
+bool IsUnitCost(const TerrainMap& terrain)
+{
+	for (int y = 0; y < terrain.GetHeight(); y++)
+	{
+		for (int x = 0; x < terrain.GetWidth(); x++)
+		{
+			ENodeType type = ENodeType(terrain[terrain.Index(x, y)]);
+			if (type != ENodeType::clear && type != ENodeType::wall)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void PrintUsage()
+{
+	cerr << "Usage: ScenarioRunner <scenario file> [--map file.map] [--searches AStar,...] [--format csv|json] [--movement four|eight|eight-cut]" << endl;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		PrintUsage();
+		return EXIT_BAD_INPUT;
+	}
+
+	string scenarioFile = argv[1];
+	string mapOverride;
+	vector<ESearchType> searches;
+	bool json = false;
+	SMovementRules movement;
+
+	for (int i = 2; i < argc; i += 2)
+	{
+		string option = argv[i];
+		if (i + 1 >= argc)
+		{
+			PrintUsage();
+			return EXIT_BAD_INPUT;
+		}
+		string value = argv[i + 1];
+
+		if (option == "--map")
+		{
+			mapOverride = value;
+		}
+		else if (option == "--searches")
+		{
+			size_t begin = 0;
+			while (begin <= value.size())
+			{
+				size_t end = value.find(',', begin);
+				if (end == string::npos)
+				{
+					end = value.size();
+				}
+
+				ESearchType searchType;
+				if (!SearchTypeFromName(value.substr(begin, end - begin), searchType))
+				{
+					cerr << "Unknown search type: " << value.substr(begin, end - begin) << endl;
+					return EXIT_BAD_INPUT;
+				}
+				searches.push_back(searchType);
+				begin = end + 1;
+			}
+		}
+		else if (option == "--format")
+		{
+			json = (value == "json");
+		}
+		else if (option == "--movement")
+		{
+			if (value != MOVEMENT_FOUR_WAY && value != MOVEMENT_EIGHT_WAY && value != MOVEMENT_EIGHT_WAY_CUT_CORNERS)
+			{
+				cerr << "Unknown movement: " << value << endl;
+				return EXIT_BAD_INPUT;
+			}
+			movement.mMovement = (value == MOVEMENT_FOUR_WAY) ? EMovement::FourWay : EMovement::EightWay;
+			movement.mCutCorners = (value == MOVEMENT_EIGHT_WAY_CUT_CORNERS);
+		}
+		else
+		{
+			cerr << "Unknown option: " << option << endl;
+			PrintUsage();
+			return EXIT_BAD_INPUT;
+		}
+	}
+
+	if (searches.empty())
+	{
+		for (int searchType = 0; searchType < ESearchType::NumOfSearches; searchType++)
+		{
+			searches.push_back(ESearchType(searchType));
+		}
+	}
+
+	vector<SScenario> scenarios;
+	if (!LoadMovingAIScenarios(scenarioFile, scenarios))
+	{
+		cerr << "Could not read scenario file " << scenarioFile << endl;
+		return EXIT_BAD_INPUT;
+	}
+
+	//Results for each search, by bucket.
+	vector<map<int, SBucketResult>> results(searches.size());
+
+	//Each search is kept for every scenario, as a program would, so searches that prepare data for a map (such as HPA*) only do it once.
+	vector<unique_ptr<ISearch>> searchObjects;
+	for (auto it = searches.begin(); it != searches.end(); it++)
+	{
+		searchObjects.push_back(unique_ptr<ISearch>(NewSearch(*it, nullptr, movement)));
+	}
+	unique_ptr<ISearch> reference(NewSearch(ESearchType::Dijkstra, nullptr, movement)); //Finds the cheapest cost of each scenario.
+
+	//Path costs are divided by this to compare them with the optimal lengths.
+	double costScale = (movement.mMovement == EMovement::EightWay) ? ORTHOGONAL_MOVE_SCALE : 1.0;
+
+	TerrainMap terrain;
+	string loadedMap; //The scenarios in a file almost always share a map, so it is only reloaded when the name changes.
+	bool checkOptimalLength = false; //True if the paths can be checked against the optimal lengths in the scenario file.
+	if (!mapOverride.empty())
+	{
+		if (!LoadMovingAIMap(mapOverride, terrain))
+		{
+			cerr << "Could not read map file " << mapOverride << endl;
+			return EXIT_BAD_INPUT;
+		}
+		checkOptimalLength = movement.mMovement == EMovement::EightWay && !movement.mCutCorners && IsUnitCost(terrain);
+	}
+
+	for (auto scenario = scenarios.begin(); scenario != scenarios.end(); scenario++)
+	{
+		if (mapOverride.empty() && scenario->mMapName != loadedMap)
+		{
+			if (!LoadScenarioMap(scenarioFile, scenario->mMapName, terrain))
+			{
+				cerr << "Could not read map file " << scenario->mMapName << endl;
+				return EXIT_BAD_INPUT;
+			}
+			loadedMap = scenario->mMapName;
+			checkOptimalLength = movement.mMovement == EMovement::EightWay && !movement.mCutCorners && IsUnitCost(terrain);
+		}
+
+		if (terrain.GetWidth() != scenario->mMapWidth || terrain.GetHeight() != scenario->mMapHeight ||
+			!terrain.InBounds(scenario->mStart.x, scenario->mStart.y) || !terrain.InBounds(scenario->mGoal.x, scenario->mGoal.y))
+		{
+			cerr << "Scenario doesn't fit the map " << scenario->mMapName << endl;
+			return EXIT_BAD_INPUT;
+		}
+
+		NodeList referencePath;
+		unique_ptr<SNode> referenceStart(new SNode{ scenario->mStart.x, scenario->mStart.y, 0 });
+		unique_ptr<SNode> referenceGoal(new SNode{ scenario->mGoal.x, scenario->mGoal.y, 0 });
+		bool reachable = reference->FindPath(terrain, move(referenceStart), move(referenceGoal), referencePath);
+		int cheapest = (reachable) ? CalculatePathCost(terrain, referencePath, movement) : 0;
+
+		for (size_t searchIndex = 0; searchIndex < searches.size(); searchIndex++)
+		{
+			unique_ptr<SNode> start(new SNode{ scenario->mStart.x, scenario->mStart.y, 0 });
+			unique_ptr<SNode> goal(new SNode{ scenario->mGoal.x, scenario->mGoal.y, 0 });
+			NodeList path;
+
+			auto startTime = chrono::steady_clock::now();
+			bool found = searchObjects[searchIndex]->FindPath(terrain, move(start), move(goal), path);
+			double microseconds = chrono::duration<double, micro>(chrono::steady_clock::now() - startTime).count();
+
+			SBucketResult& bucket = results[searchIndex][scenario->mBucket];
+			bucket.mScenarios++;
+			bucket.mMicroseconds.push_back(microseconds);
+
+			if (found != reachable)
+			{
+				bucket.mFailed++;
+				continue;
+			}
+			if (!found)
+			{
+				continue; //Correctly found that there is no path.
+			}
+
+			int cost = CalculatePathCost(terrain, path, movement);
+			double length = cost / costScale;
+			double epsilon = searchObjects[searchIndex]->GetStats().mEpsilon;
+			if (!IsPathValid(terrain, path, scenario->mStart, scenario->mGoal, movement) || cost < cheapest ||
+				(epsilon > 0.0 && cost > epsilon * cheapest + EPSILON_TOLERANCE))
+			{
+				bucket.mFailed++;
+				continue;
+			}
+			if (checkOptimalLength && (length < scenario->mOptimalLength * SHORTEST_OCTILE_RATIO - OPTIMAL_LENGTH_TOLERANCE ||
+				(epsilon > 0.0 && length > epsilon * scenario->mOptimalLength + OPTIMAL_LENGTH_TOLERANCE)))
+			{
+				bucket.mFailed++;
+				continue;
+			}
+			if (cost > cheapest)
+			{
+				bucket.mSuboptimal++;
+			}
+			if (scenario->mOptimalLength > 0.0)
+			{
+				bucket.mTotalRatio += length / scenario->mOptimalLength;
+				bucket.mRatioCount++;
+			}
+		}
+	}
+
+	if (json)
+	{
+		cout << "[" << endl;
+	}
+	else
+	{
+		cout << "search,bucket,scenarios,failed,suboptimal,mean cost ratio,p50 us,p90 us,p99 us,max us" << endl;
+	}
+
+	bool anyFailed = false;
+	bool first = true;
+	for (size_t searchIndex = 0; searchIndex < searches.size(); searchIndex++)
+	{
+		for (auto it = results[searchIndex].begin(); it != results[searchIndex].end(); it++)
+		{
+			SBucketResult& bucket = it->second;
+			sort(bucket.mMicroseconds.begin(), bucket.mMicroseconds.end());
+			double meanRatio = (bucket.mRatioCount > 0) ? bucket.mTotalRatio / bucket.mRatioCount : 0.0;
+			anyFailed = anyFailed || bucket.mFailed > 0;
+
+			if (json)
+			{
+				cout << (first ? "  " : ", ") << "{ \"search\": \"" << SEARCH_TYPE_NAMES[searches[searchIndex]] << "\", \"bucket\": " << it->first
+					 << ", \"scenarios\": " << bucket.mScenarios << ", \"failed\": " << bucket.mFailed << ", \"suboptimal\": " << bucket.mSuboptimal << ", \"meanCostRatio\": " << meanRatio
+					 << ", \"p50Microseconds\": " << Percentile(bucket.mMicroseconds, 50) << ", \"p90Microseconds\": " << Percentile(bucket.mMicroseconds, 90)
+					 << ", \"p99Microseconds\": " << Percentile(bucket.mMicroseconds, 99) << ", \"maxMicroseconds\": " << bucket.mMicroseconds.back() << " }" << endl;
+			}
+			else
+			{
+				cout << SEARCH_TYPE_NAMES[searches[searchIndex]] << "," << it->first << "," << bucket.mScenarios << "," << bucket.mFailed << "," << bucket.mSuboptimal << "," << meanRatio << ","
+					 << Percentile(bucket.mMicroseconds, 50) << "," << Percentile(bucket.mMicroseconds, 90) << ","
+					 << Percentile(bucket.mMicroseconds, 99) << "," << bucket.mMicroseconds.back() << endl;
+			}
+			first = false;
+		}
+	}
+
+	if (json)
+	{
+		cout << "]" << endl;
+	}
+
+	return (anyFailed) ? EXIT_SOME_FAILED : EXIT_ALL_PASSED;
+}
@@ -9,7 +9,25 @@
 #pragma once
 
 #include "Definitions.h" // type definitions
+#include "TerrainMap.h" // Flat grid of terrain
 #include "SearchUtilities.h" //Functions shared between search solutions
+#include "NodePool.h" // Node allocation counters
+#include <chrono>
+
+//Statistics of one query, filled in by every search. Read them with ISearch::GetStats after FindPath, or after the last StepPath.
+//Counting costs an increment or two per node, so they are always on.
+struct SSearchStats
+{
+	long long mNodesExpanded = 0; //Nodes taken from the open list and expanded.
+	long long mNodesGenerated = 0; //Nodes put on the open list, including ones put back when a cheaper route to them was found.
+	long long mReopenings = 0; //Nodes put back on the open list after they had been expanded, because a cheaper route to them was found.
+	long long mPeakOpenSize = 0; //The most nodes on the open list at once, including out of date entries still waiting to be skipped.
+	long long mPeakClosedSize = 0; //The most nodes on the closed list at once. 0 for searches without one.
+	long long mHeapBytes = 0; //Memory taken from the heap during the query: node pool blocks, and growth of the search's own arrays. 0 once warmed up.
+	long long mScratchBytes = 0; //Memory held by the search's own arrays at the end of the query, besides nodes. They only grow, so this is also the peak.
+	double mEpsilon = 1.0; //The path costs at most this many times the cheapest path. 0 for searches with no bound: breadth first, and HPA*.
+	double mMilliseconds = 0.0; //Wall time of the query. For a search run with StepPath, from the first step to the last, including the time between steps.
+};
 
 // ISearch interface class - cannot be instantiated
 // Implementation classes for specific search algorithms should inherit from this interface
@@ -28,18 +46,60 @@ public:
 
   // Constructs the path from start to goal for the given terrain
   // Pure Virtual function to be implemented in derived class.
-  virtual bool FindPath(TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path) = 0;
+  // The terrain is only read, so many searches on different threads can share one map. A search object keeps scratch state
+  // between calls, so each thread needs its own; See CBatchSearch.
+  virtual bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path) = 0;
 
   // Performs a single step of the FindPath function.
   // Performs the function of the loop in FindPath. Start should be the current node the first time StepPath is called.
   // Takes the openlist and closedlist as additionally reference parameters; These are used to set textures and create models.
   // Goal is passed as a reference parameter because it is used for comparison; It is not added onto the openlist until it is found by the search.
-  virtual EStepPathResults StepPath(TerrainMap& terrain, NodeList& mOpenList, NodeList& mClosedList, unique_ptr<SNode>& goal, NodeList& path) = 0;
-  /* TODO - Only for high marks
-     Add a pure virtual function declaration to perform one iteration of the path-finding loop.
-     This is in support of showing the search in real time.
-     The main program will need to display somehow:
-     - the open list
-     - the closed list
-     - the path to the current node */
+  // CSearchContext owns these lists between steps, and runs a given number of steps or until a deadline; See SearchContext.h.
+  virtual EStepPathResults StepPath(const TerrainMap& terrain, NodeList& mOpenList, NodeList& mClosedList, unique_ptr<SNode>& goal, NodeList& path) = 0;
+
+  // The statistics of the last query, or of the query in progress.
+  const SSearchStats& GetStats() const
+  {
+	  return mStats;
+  }
+
+protected:
+  SSearchStats mStats;
+
+  // Call at the start of each query. Clears the statistics and starts the clock.
+  void StartStats()
+  {
+	  mStats = SSearchStats();
+	  mStatsStartTime = chrono::steady_clock::now();
+	  mStatsStartBlocks = CNodePool::GetCounters().mHeapAllocations;
+	  mStatsStartScratch = ScratchBytes();
+  }
+
+  // Call when the query has finished, whether or not a path was found.
+  void FinishStats()
+  {
+	  mStats.mMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - mStatsStartTime).count();
+	  long long blocks = CNodePool::GetCounters().mHeapAllocations - mStatsStartBlocks;
+	  mStats.mScratchBytes = ScratchBytes();
+	  mStats.mHeapBytes = blocks * NODE_POOL_BLOCK_SIZE * sizeof(SNode) + max(0LL, mStats.mScratchBytes - mStatsStartScratch);
+  }
+
+  // Records the sizes of the lists, if they are the largest so far.
+  void UpdatePeaks(long long openSize, long long closedSize)
+  {
+	  mStats.mPeakOpenSize = max(mStats.mPeakOpenSize, openSize);
+	  mStats.mPeakClosedSize = max(mStats.mPeakClosedSize, closedSize);
+  }
+
+  // The memory held by the search's own arrays, which are kept between queries. Reported as mScratchBytes; Only the growth during a query
+  // counts towards mHeapBytes.
+  virtual long long ScratchBytes() const
+  {
+	  return 0;
+  }
+
+private:
+  chrono::steady_clock::time_point mStatsStartTime;
+  long long mStatsStartBlocks = 0;
+  long long mStatsStartScratch = 0;
 };
\ No newline at end of file
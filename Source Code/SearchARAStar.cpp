@@ -0,0 +1,271 @@
+//Leo Croft
+
+// SearchARAStar.cpp
+// =================
+//
+// Implementation of Search class for Anytime Repairing A* (ARA*)
+//
+
+#include "SearchARAStar.h" // Declaration of this class
+#include <climits>
+#include <cstdlib>
+
+//A step of 0 or less goes straight from the first pass to ε of 1.
+CSearchARAStar::CSearchARAStar(double initialEpsilon, double epsilonStep, const SMovementRules& movement) : mInitialEpsilon(max(1.0, initialEpsilon)),
+	mEpsilonStep((epsilonStep > 0.0) ? epsilonStep : initialEpsilon), mMovement(movement)
+{
+}
+
+//The Manhattan (or octile) distance from the square to the goal.
+int CSearchARAStar::Heuristic(const TerrainMap& terrain, int index) const
+{
+	return mMovement.Distance(terrain.IndexToX(index) - terrain.IndexToX(mGoalIndex), terrain.IndexToY(index) - terrain.IndexToY(mGoalIndex));
+}
+
+//Puts the square on the open list with its current cost, scored for the current ε.
+void CSearchARAStar::Push(const TerrainMap& terrain, int index)
+{
+	if (mClosed[index] >= mQueryStamp)
+	{
+		mStats.mReopenings++;
+	}
+	mOpen.push_back({ mCosts[index] + mEpsilon * Heuristic(terrain, index), mCosts[index], index });
+	push_heap(mOpen.begin(), mOpen.end(), greater<SQueueEntry>());
+	mStats.mNodesGenerated++;
+}
+
+//Resets the search for a new query, and starts the first pass. Returns false if the goal can't be reached.
+bool CSearchARAStar::Start(const TerrainMap& terrain, int startIndex, int goalIndex)
+{
+	mStartIndex = startIndex;
+	mGoalIndex = goalIndex;
+	mOpen.clear();
+	mInconsistentList.clear();
+	mEpsilon = mInitialEpsilon;
+	mBound = 0.0;
+	StartStats();
+	if (terrain[goalIndex] == ENodeType::wall || !mMovement.CanReach(terrain, startIndex, goalIndex))
+	{
+		FinishStats();
+		return false;
+	}
+
+	//Stamps older than mQueryStamp are from previous searches. Start again from 0 well before the stamps overflow, as each pass takes one.
+	if (int(mStamps.size()) != terrain.Size() || mStamp >= UINT_MAX / 2)
+	{
+		mCosts.assign(terrain.Size(), 0);
+		mParents.assign(terrain.Size(), -1);
+		mStamps.assign(terrain.Size(), 0);
+		mClosed.assign(terrain.Size(), 0);
+		mInconsistent.assign(terrain.Size(), 0);
+		mStamp = 0;
+	}
+	mQueryStamp = ++mStamp;
+	mPassStamp = ++mStamp;
+
+	mStamps[startIndex] = mQueryStamp;
+	mCosts[startIndex] = 0;
+	mParents[startIndex] = -1;
+	Push(terrain, startIndex);
+	return true;
+}
+
+//Expands the next square on the open list. Returns the square expanded, or -1 if the pass has finished.
+int CSearchARAStar::Expand(const TerrainMap& terrain)
+{
+	while (!mOpen.empty() && IsStale(mOpen.front()))
+	{
+		pop_heap(mOpen.begin(), mOpen.end(), greater<SQueueEntry>());
+		mOpen.pop_back();
+	}
+
+	//The goal's score is its cost, as its estimate is 0. Once nothing on the open list scores lower, the pass can't improve the path.
+	bool goalReached = (mStamps[mGoalIndex] == mQueryStamp);
+	if (mOpen.empty() || (goalReached && mCosts[mGoalIndex] <= mOpen.front().mScore))
+	{
+		return -1;
+	}
+
+	SQueueEntry current = mOpen.front();
+	pop_heap(mOpen.begin(), mOpen.end(), greater<SQueueEntry>());
+	mOpen.pop_back();
+	mClosed[current.mIndex] = mPassStamp;
+	mStats.mNodesExpanded++;
+
+	//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+	for (int compass = 0; compass < mMovement.NumDirections(); compass++)
+	{
+		int neighbour = current.mIndex + SMovementRules::Offset(terrain, compass);
+		if (!mMovement.CanMove(terrain, current.mIndex, compass))
+		{
+			continue;
+		}
+
+		int cost = current.mCost + mMovement.MoveCost(terrain, neighbour, compass);
+		if (mStamps[neighbour] == mQueryStamp && mCosts[neighbour] <= cost)
+		{
+			continue;
+		}
+		mStamps[neighbour] = mQueryStamp;
+		mCosts[neighbour] = cost;
+		mParents[neighbour] = current.mIndex;
+
+		//A square already expanded this pass isn't expanded again until the next one.
+		if (mClosed[neighbour] != mPassStamp)
+		{
+			Push(terrain, neighbour);
+		}
+		else if (mInconsistent[neighbour] != mPassStamp)
+		{
+			mInconsistent[neighbour] = mPassStamp;
+			mInconsistentList.push_back(neighbour);
+		}
+	}
+	UpdatePeaks(mOpen.size(), mStats.mNodesExpanded);
+	return current.mIndex;
+}
+
+//Works out the bound on the path of the pass that has just finished. If the path could still improve and there is time left,
+//lowers ε and starts the next pass, and returns true.
+bool CSearchARAStar::NextPass(const TerrainMap& terrain)
+{
+	//Every cheaper path passes through a square on the open or inconsistent lists, so it can't cost less than the lowest cost plus
+	//estimate among them.
+	int lowest = INT_MAX;
+	for (auto it = mOpen.begin(); it != mOpen.end(); it++)
+	{
+		if (!IsStale(*it))
+		{
+			lowest = min(lowest, (*it).mCost + Heuristic(terrain, (*it).mIndex));
+		}
+	}
+	for (auto it = mInconsistentList.begin(); it != mInconsistentList.end(); it++)
+	{
+		lowest = min(lowest, mCosts[*it] + Heuristic(terrain, *it));
+	}
+	double bound = (lowest == INT_MAX) ? 1.0 : min(mEpsilon, double(mCosts[mGoalIndex]) / lowest);
+	mBound = max(1.0, bound);
+	mStats.mEpsilon = mBound;
+
+	if (mBound <= 1.0 || chrono::steady_clock::now() >= mDeadline)
+	{
+		return false;
+	}
+
+	//The next pass needs a smaller ε than the bound already proven, or it can't find a better path.
+	mEpsilon = max(1.0, min(mEpsilon - mEpsilonStep, mBound));
+	vector<SQueueEntry> previous;
+	previous.swap(mOpen);
+
+	//Squares expanded last pass can be expanded again, so a new stamp is taken before the old entries are checked.
+	unsigned int previousPass = mPassStamp;
+	mPassStamp = ++mStamp;
+	for (auto it = previous.begin(); it != previous.end(); it++)
+	{
+		if (mClosed[(*it).mIndex] != previousPass && mCosts[(*it).mIndex] == (*it).mCost)
+		{
+			mOpen.push_back({ (*it).mCost + mEpsilon * Heuristic(terrain, (*it).mIndex), (*it).mCost, (*it).mIndex });
+		}
+	}
+	make_heap(mOpen.begin(), mOpen.end(), greater<SQueueEntry>());
+	for (auto it = mInconsistentList.begin(); it != mInconsistentList.end(); it++)
+	{
+		Push(terrain, *it);
+	}
+	mInconsistentList.clear();
+	return true;
+}
+
+//Follows the parents back from the goal.
+void CSearchARAStar::BuildPath(const TerrainMap& terrain, NodeList& path) const
+{
+	for (int index = mGoalIndex; index != -1; index = mParents[index])
+	{
+		path.push_front(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+	}
+}
+
+// The search keeps its own open list, so FindPath doesn't create any nodes until the path is built.
+bool CSearchARAStar::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+{
+	if (!Start(terrain, terrain.Index(start->x, start->y), terrain.Index(goal->x, goal->y)))
+	{
+		return false;
+	}
+
+	//Once the first pass has found a path, the deadline is checked part way through passes as well as between them.
+	//The parents always lead back to the start, and the path they give costs no more than the last finished pass's did.
+	long long expanded = 0;
+	while (true)
+	{
+		if (Expand(terrain) == -1)
+		{
+			//Without a component index on the map, the first pass can run out of squares without reaching the goal.
+			if (mStamps[mGoalIndex] != mQueryStamp)
+			{
+				FinishStats();
+				return false;
+			}
+			if (!NextPass(terrain))
+			{
+				break;
+			}
+		}
+		else if (mBound > 0.0 && ++expanded % ARA_CLOCK_INTERVAL == 0 && chrono::steady_clock::now() >= mDeadline)
+		{
+			break;
+		}
+	}
+
+	BuildPath(terrain, path);
+	FinishStats();
+	return true;
+}
+
+EStepPathResults CSearchARAStar::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+{
+	//The closed list is only empty on the first step of a search, when the open list holds the start node.
+	if (closedList.empty())
+	{
+		if (openList.empty() || !Start(terrain, terrain.Index(openList.front()->x, openList.front()->y), terrain.Index(goal->x, goal->y)))
+		{
+			return EStepPathResults::NO_PATH;
+		}
+		closedList.push_back(move(openList.front()));
+		openList.clear();
+	}
+
+	int expanded = Expand(terrain);
+	if (expanded != -1)
+	{
+		closedList.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(expanded), terrain.IndexToY(expanded), 0 }));
+		if (mBound == 0.0 || chrono::steady_clock::now() < mDeadline)
+		{
+			return EStepPathResults::STEP_SUCCESS;
+		}
+	}
+	else if (mStamps[mGoalIndex] != mQueryStamp)
+	{
+		//Without a component index on the map, the first pass can run out of squares without reaching the goal.
+		FinishStats();
+		return EStepPathResults::NO_PATH;
+	}
+	else
+	{
+		//The pass has finished, so its path replaces the last one. A caller that stops stepping early still has a path.
+		path.clear();
+		BuildPath(terrain, path);
+		if (NextPass(terrain))
+		{
+			return EStepPathResults::STEP_SUCCESS;
+		}
+	}
+
+	if (expanded != -1)
+	{
+		path.clear();
+		BuildPath(terrain, path);
+	}
+	FinishStats();
+	return EStepPathResults::PATH_FOUND;
+}
@@ -0,0 +1,123 @@
+//Leo Croft
+
+// SearchARAStar.h
+// ===============
+//
+// Declaration of Search class for Anytime Repairing A* (ARA*)
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include "Movement.h"     // Four or eight way movement
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+const double ARA_INITIAL_EPSILON = 3.0; //The weight on the heuristic for the first pass.
+const double ARA_EPSILON_STEP = 0.5; //How much the weight is lowered for each pass after.
+const int ARA_CLOCK_INTERVAL = 64; //The number of nodes expanded between readings of the clock, once there is a path to return.
+
+// A* with the heuristic multiplied by a weight ε. A weighted heuristic heads for the goal greedily, so the first path is found after
+// expanding far fewer nodes, and costs at most ε times the cheapest. The search then lowers ε and runs again, and keeps going until
+// the path is the cheapest (ε reaches 1) or the deadline passes, and returns the best path found.
+//
+// Each pass carries on from the last instead of starting again. Costs found by earlier passes are kept, and only the squares whose
+// cost has dropped since they were expanded (the inconsistent squares) are put back on the open list, along with the open list itself.
+// Within a pass each square is expanded at most once; A square that gets cheaper after it is expanded waits for the next pass.
+//
+// The bound the path was found under is reported in SSearchStats::mEpsilon. It is often tighter than the ε of the pass, as the cheapest
+// path can't cost less than the lowest cost plus estimate left on the open and inconsistent lists.
+class CSearchARAStar : public ISearch
+{
+private:
+	//An entry in the open list. Entries are not removed when a better route is found; The out of date ones are skipped.
+	struct SQueueEntry
+	{
+		double mScore; //The cost plus ε times the estimate.
+		int mCost;
+		int mIndex;
+
+		//Ties are broken towards the node furthest from the start, as they are closer to the goal.
+		bool operator>(const SQueueEntry& other) const
+		{
+			return mScore > other.mScore || (mScore == other.mScore && mCost < other.mCost);
+		}
+	};
+
+	double mInitialEpsilon;
+	double mEpsilonStep;
+	SMovementRules mMovement;
+	chrono::steady_clock::time_point mDeadline = chrono::steady_clock::time_point::max();
+
+	//Search state, indexed the same way as the TerrainMap. A square's cost and parent are only valid if its stamp is mQueryStamp.
+	//A square was expanded this query if its closed stamp is at least mQueryStamp, and this pass if it is mPassStamp.
+	vector<int> mCosts;
+	vector<int> mParents;
+	vector<unsigned int> mStamps;
+	vector<unsigned int> mClosed;
+	vector<unsigned int> mInconsistent; //A square is on mInconsistentList if this is mPassStamp.
+	unsigned int mStamp = 0; //The last stamp given out. Each query and each pass takes a new one.
+	unsigned int mQueryStamp = 0;
+	unsigned int mPassStamp = 0;
+
+	vector<SQueueEntry> mOpen; //A heap, kept with push_heap and pop_heap so it can be rebuilt for a new ε.
+	vector<int> mInconsistentList; //Squares that got cheaper after they were expanded this pass.
+
+	int mStartIndex = 0;
+	int mGoalIndex = 0;
+	double mEpsilon = 1.0; //The weight of the current pass.
+	double mBound = 0.0; //The bound on the cost of the path found by the last finished pass. 0 until the first pass has finished.
+
+	long long ScratchBytes() const
+	{
+		return (mCosts.capacity() + mParents.capacity() + mInconsistentList.capacity()) * sizeof(int) +
+			(mStamps.capacity() + mClosed.capacity() + mInconsistent.capacity()) * sizeof(unsigned int) + mOpen.capacity() * sizeof(SQueueEntry);
+	}
+
+	//The Manhattan (or octile, with eight way movement) distance from the square to the goal.
+	int Heuristic(const TerrainMap& terrain, int index) const;
+
+	//True if the entry is out of date: its square has been expanded this pass, or reached more cheaply since.
+	bool IsStale(const SQueueEntry& entry) const
+	{
+		return mClosed[entry.mIndex] == mPassStamp || mCosts[entry.mIndex] != entry.mCost;
+	}
+
+	//Puts the square on the open list with its current cost, scored for the current ε.
+	void Push(const TerrainMap& terrain, int index);
+
+	//Resets the search for a new query, and starts the first pass. Returns false if the goal can't be reached.
+	bool Start(const TerrainMap& terrain, int startIndex, int goalIndex);
+
+	//Expands the next square on the open list. Returns the square expanded, or -1 if the pass has finished because nothing left on the
+	//open list can lead to a cheaper path to the goal under the current ε.
+	int Expand(const TerrainMap& terrain);
+
+	//Works out the bound on the path of the pass that has just finished. If the path could still improve and there is time left,
+	//lowers ε and starts the next pass, and returns true.
+	bool NextPass(const TerrainMap& terrain);
+
+	//Follows the parents back from the goal.
+	void BuildPath(const TerrainMap& terrain, NodeList& path) const;
+
+public:
+	//The first pass uses initialEpsilon, and each pass after lowers it by epsilonStep, down to 1. A step of 0 or less goes straight to 1.
+	CSearchARAStar(double initialEpsilon = ARA_INITIAL_EPSILON, double epsilonStep = ARA_EPSILON_STEP, const SMovementRules& movement = SMovementRules());
+
+	//Searches stop improving their path at the deadline, and return the best one found. The first path is always found, however long
+	//it takes, so there is something to return. The deadline stays until it is changed; The default of time_point::max() searches
+	//until the path is the cheapest.
+	void SetDeadline(chrono::steady_clock::time_point deadline)
+	{
+		mDeadline = deadline;
+	}
+
+	// Constructs the path from start to goal for the given terrain
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+
+	// Each step expands one node, and adds it to the closed list. When a pass finishes its path replaces the one in path, and the search
+	// carries on with the next pass. PATH_FOUND is returned once the path is the cheapest or the deadline has passed.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
+};
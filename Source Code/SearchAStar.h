@@ -1,30 +1,37 @@
 //Leo Croft
 
 // SearchAStar.h
-// ======^^^^^^==
+// =============
 //
-// Declaration of Search class for Breadth First algorithm
+// Declaration of Search classes for the A* algorithm
 //
 
 #pragma once
 
 #include "Definitions.h"  // Type definitions
-#include "Search.h"       // Base (=interface) class definition
+#include "SearchKernel.h" // The search the A* classes are built from
 
-// Breadth First search class definition
+// A* with the Manhattan distance as its heuristic, and each of the open lists.
+typedef CSearchKernel<SFourConnected, CManhattanHeuristic, CHeapOpenList> CSearchAStar;
+typedef CSearchKernel<SFourConnected, CManhattanHeuristic, CBucketOpenList> CSearchAStarBuckets;
 
-// Inherit from interface and provide implementation for 0* algorithm
-class CSearchAStar: public ISearch
-{
-	// I have not implemented any constructors or destructors.
-	// Whether you need some is up to how you choose to do your implementation.
+// A* with the ALT heuristic as well as the Manhattan distance. Pass the landmarks to the constructor: CLandmarkHeuristic(landmarks).
+typedef CSearchKernel<SFourConnected, CLandmarkHeuristic, CHeapOpenList> CSearchAStarLandmarks;
+typedef CSearchKernel<SFourConnected, CLandmarkHeuristic, CBucketOpenList> CSearchAStarBucketsLandmarks;
 
-	// Constructs the path from start to goal for the given terrain
-	bool FindPath(TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+// A* with eight way movement and the octile distance. Pass SEightConnected(cutCorners) to the constructor to allow cutting corners.
+// The landmark bounds are four way costs, which overestimate eight way ones, so there is no eight way version with landmarks.
+typedef CSearchKernel<SEightConnected, COctileHeuristic, CHeapOpenList> CSearchAStarEightWay;
+typedef CSearchKernel<SEightConnected, COctileHeuristic, CBucketOpenList> CSearchAStarBucketsEightWay;
 
-	// Performs a single step of the FindPath function.
-	// Performs the function of the loop in FindPath. Start should be the first node in openlist the first time StepPath is called.
-	// Takes the openlist and closedlist as additionally reference parameters; These are used to set textures and create models.
-	// Goal is passed as a reference parameter because it is used for comparison; It is not added onto the openlist until it is found by the search.
-	EStepPathResults StepPath(TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
-};
\ No newline at end of file
+// A* with the open list sorted before every pop, as it was before the binary heap. Only used by Benchmark, as AStarSorted.
+typedef CSearchKernel<SFourConnected, CManhattanHeuristic, CSortedOpenList> CSearchAStarSorted;
+
+// The kernels are compiled once, in SearchAStar.cpp, rather than in every file that includes this one.
+extern template class CSearchKernel<SFourConnected, CManhattanHeuristic, CHeapOpenList>;
+extern template class CSearchKernel<SFourConnected, CManhattanHeuristic, CBucketOpenList>;
+extern template class CSearchKernel<SFourConnected, CLandmarkHeuristic, CHeapOpenList>;
+extern template class CSearchKernel<SFourConnected, CLandmarkHeuristic, CBucketOpenList>;
+extern template class CSearchKernel<SEightConnected, COctileHeuristic, CHeapOpenList>;
+extern template class CSearchKernel<SEightConnected, COctileHeuristic, CBucketOpenList>;
+extern template class CSearchKernel<SFourConnected, CManhattanHeuristic, CSortedOpenList>;
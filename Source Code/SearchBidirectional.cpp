@@ -0,0 +1,239 @@
+//Leo Croft
+
+// SearchBidirectional.cpp
+// =======================
+//
+// Implementation of Search class for bidirectional Breadth First and A* algorithms
+//
+
+#include "SearchBidirectional.h" // Declaration of this class
+#include <climits>
+#include <cstdlib>
+
+const int BIDIRECTIONAL_INFINITY = INT_MAX / 2; //Larger than any path cost, but can still be added to without overflowing.
+
+CSearchBidirectional::CSearchBidirectional(bool weighted, const SMovementRules& movement) : mWeighted(weighted), mMovement(movement)
+{
+}
+
+//Resets both searches for a new query. Returns false if the goal can't be reached.
+bool CSearchBidirectional::Start(const TerrainMap& terrain, int startIndex, int goalIndex)
+{
+	mStartIndex = startIndex;
+	mGoalIndex = goalIndex;
+	mBestCost = BIDIRECTIONAL_INFINITY;
+	mMeeting = -1;
+	StartStats();
+	if (!mWeighted)
+	{
+		mStats.mEpsilon = 0.0; //The fewest steps, not the cheapest, so there is no bound on the cost.
+	}
+	if (terrain[goalIndex] == ENodeType::wall || !mMovement.CanReach(terrain, startIndex, goalIndex))
+	{
+		FinishStats();
+		return false;
+	}
+
+	//Stamps older than mStamp are from previous searches. Start again from 0 before the stamps overflow.
+	if (int(mDirections[FORWARD].mStamps.size()) != terrain.Size() || mStamp == UINT_MAX)
+	{
+		for (int side = FORWARD; side <= BACKWARD; side++)
+		{
+			mDirections[side].mCosts.assign(terrain.Size(), 0);
+			mDirections[side].mParents.assign(terrain.Size(), -1);
+			mDirections[side].mStamps.assign(terrain.Size(), 0);
+			mDirections[side].mClosed.assign(terrain.Size(), 0);
+		}
+		mStamp = 0;
+	}
+	mStamp++;
+
+	mDirections[FORWARD].mTarget = goalIndex;
+	mDirections[BACKWARD].mTarget = startIndex;
+	for (int side = FORWARD; side <= BACKWARD; side++)
+	{
+		mDirections[side].mOpen = {};
+	}
+	Relax(terrain, FORWARD, startIndex, -1, 0);
+	Relax(terrain, BACKWARD, goalIndex, -1, 0);
+	return true;
+}
+
+int CSearchBidirectional::Heuristic(const TerrainMap& terrain, int side, int index) const
+{
+	if (!mWeighted)
+	{
+		return 0;
+	}
+	int target = mDirections[side].mTarget;
+	return mMovement.Distance(terrain.IndexToX(index) - terrain.IndexToX(target), terrain.IndexToY(index) - terrain.IndexToY(target));
+}
+
+//Lowers the cost of a square in one search, if the new cost is cheaper, and checks whether it is now a cheaper meeting.
+void CSearchBidirectional::Relax(const TerrainMap& terrain, int side, int index, int parent, int cost)
+{
+	SDirection& direction = mDirections[side];
+	if (direction.mStamps[index] == mStamp && direction.mCosts[index] <= cost)
+	{
+		return;
+	}
+	direction.mStamps[index] = mStamp;
+	direction.mCosts[index] = cost;
+	direction.mParents[index] = parent;
+
+	const SDirection& other = mDirections[1 - side];
+	if (other.mStamps[index] == mStamp && cost + other.mCosts[index] < mBestCost)
+	{
+		mBestCost = cost + other.mCosts[index];
+		mMeeting = index;
+	}
+
+	//A node whose cost and estimate have reached the cheapest meeting can't be on a cheaper path, so it is never expanded.
+	int estimate = Heuristic(terrain, side, index);
+	if (cost + estimate < mBestCost)
+	{
+		direction.mOpen.push({ 2 * cost + estimate - Heuristic(terrain, 1 - side, index), cost, index });
+		mStats.mNodesGenerated++;
+	}
+}
+
+//Removes the out of date entries from the front of a search's open list.
+void CSearchBidirectional::SkipStale(SDirection& direction)
+{
+	while (!direction.mOpen.empty())
+	{
+		const SQueueEntry& top = direction.mOpen.top();
+		if (direction.mClosed[top.mIndex] != mStamp && direction.mCosts[top.mIndex] == top.mCost)
+		{
+			return;
+		}
+		direction.mOpen.pop();
+	}
+}
+
+//Expands the next node of whichever search has the smaller open list. Returns the square expanded, or -1 if the search has finished.
+int CSearchBidirectional::Expand(const TerrainMap& terrain, EStepPathResults& result)
+{
+	SDirection& forward = mDirections[FORWARD];
+	SDirection& backward = mDirections[BACKWARD];
+	SkipStale(forward);
+	SkipStale(backward);
+
+	//If either search has run out of nodes, it has reached every square it can, so the cheapest meeting can't improve.
+	bool finished = forward.mOpen.empty() || backward.mOpen.empty();
+	if (!finished)
+	{
+		finished = forward.mOpen.top().mScore + backward.mOpen.top().mScore >= 2 * mBestCost;
+	}
+	if (finished)
+	{
+		result = (mMeeting >= 0) ? EStepPathResults::PATH_FOUND : EStepPathResults::NO_PATH;
+		FinishStats();
+		return -1;
+	}
+
+	int side = (forward.mOpen.size() <= backward.mOpen.size()) ? FORWARD : BACKWARD;
+	SDirection& direction = mDirections[side];
+	SQueueEntry current = direction.mOpen.top();
+	direction.mOpen.pop();
+	direction.mClosed[current.mIndex] = mStamp;
+	mStats.mNodesExpanded++;
+
+	//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+	for (int compass = 0; compass < mMovement.NumDirections(); compass++)
+	{
+		int neighbour = current.mIndex + SMovementRules::Offset(terrain, compass);
+		if (!mMovement.CanMove(terrain, current.mIndex, compass) || direction.mClosed[neighbour] == mStamp)
+		{
+			continue;
+		}
+
+		//Forwards the move is onto the neighbour. Backwards the move is from the neighbour onto the current square, which costs the same
+		//apart from the terrain.
+		int moveCost = (!mWeighted) ? 1 : (side == FORWARD) ? mMovement.MoveCost(terrain, neighbour, compass) : mMovement.MoveCost(terrain, current.mIndex, compass);
+		Relax(terrain, side, neighbour, current.mIndex, current.mCost + moveCost);
+	}
+	UpdatePeaks(forward.mOpen.size() + backward.mOpen.size(), mStats.mNodesExpanded);
+
+	result = EStepPathResults::STEP_SUCCESS;
+	return current.mIndex;
+}
+
+//Joins the two halves of the path at the meeting square.
+void CSearchBidirectional::BuildPath(const TerrainMap& terrain, NodeList& path) const
+{
+	//Follow the forward search back to the start, then the backward search on to the goal.
+	NodeList firstHalf;
+	for (int index = mMeeting; index != -1; index = mDirections[FORWARD].mParents[index])
+	{
+		firstHalf.push_front(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+	}
+	for (auto it = firstHalf.begin(); it != firstHalf.end(); it++)
+	{
+		path.push_back(move(*it));
+	}
+	for (int index = mDirections[BACKWARD].mParents[mMeeting]; index != -1; index = mDirections[BACKWARD].mParents[index])
+	{
+		path.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+	}
+}
+
+// The searches keep their own open lists, so FindPath doesn't create any nodes until the path is built.
+bool CSearchBidirectional::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+{
+	if (!Start(terrain, terrain.Index(start->x, start->y), terrain.Index(goal->x, goal->y)))
+	{
+		return false;
+	}
+
+	EStepPathResults result;
+	while (Expand(terrain, result) != -1)
+	{
+	}
+
+	if (result == EStepPathResults::PATH_FOUND)
+	{
+		BuildPath(terrain, path);
+		return true;
+	}
+	return false;
+}
+
+EStepPathResults CSearchBidirectional::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+{
+	//The closed list is only empty on the first step of a search, when the open list holds the start node.
+	if (closedList.empty())
+	{
+		if (openList.empty() || !Start(terrain, terrain.Index(openList.front()->x, openList.front()->y), terrain.Index(goal->x, goal->y)))
+		{
+			return EStepPathResults::NO_PATH;
+		}
+		closedList.push_back(move(openList.front()));
+		openList.clear();
+	}
+
+	EStepPathResults result;
+	int expanded = Expand(terrain, result);
+	if (expanded != -1)
+	{
+		closedList.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(expanded), terrain.IndexToY(expanded), 0 }));
+	}
+	else if (result == EStepPathResults::PATH_FOUND)
+	{
+		BuildPath(terrain, path);
+	}
+	return result;
+}
+
+//The memory held by the arrays of both searches.
+long long CSearchBidirectional::ScratchBytes() const
+{
+	long long bytes = 0;
+	for (int side = FORWARD; side <= BACKWARD; side++)
+	{
+		const SDirection& direction = mDirections[side];
+		bytes += (direction.mCosts.capacity() + direction.mParents.capacity()) * sizeof(int) +
+			(direction.mStamps.capacity() + direction.mClosed.capacity()) * sizeof(unsigned int);
+	}
+	return bytes;
+}
@@ -0,0 +1,101 @@
+//Leo Croft
+
+// SearchBidirectional.h
+// =====================
+//
+// Declaration of Search class for bidirectional Breadth First and A* algorithms
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include "Movement.h"     // Four or eight way movement
+#include <queue>
+#include <functional>
+
+// Runs one search forwards from the start and another backwards from the goal, taking turns to expand a node from whichever has the
+// smaller open list, until they meet. Each search covers roughly half the distance, so far fewer nodes are expanded on open maps.
+//
+// Moving onto a square costs its terrain, so the backward search pays the terrain of the square it moves off, not the one it moves onto.
+// The first square where the searches meet is not always on the cheapest path, so the search keeps the cheapest meeting found so far,
+// and only stops once neither search can find a cheaper one.
+//
+// Breadth first counts every step as 1 and has no heuristic. It stops when the smallest costs on the two open lists add up to the cheapest
+// meeting. The A* version orders the searches so the same test can be used: Both share one estimate, half the Manhattan distance to the goal
+// minus half the Manhattan distance to the start, which the forward search adds and the backward search subtracts. (Each search steering
+// for its own end instead makes the searches pass each other, and they expand more nodes between them than A* does alone.)
+// Scores are doubled to keep them whole numbers. Nodes whose cost plus Manhattan distance to their own end reaches the cheapest meeting
+// are never put on the open lists. With eight way movement the octile distance is used in place of the Manhattan distance.
+class CSearchBidirectional : public ISearch
+{
+private:
+	//An entry in the open lists. Entries are not removed when a better route is found; The out of date ones are skipped.
+	struct SQueueEntry
+	{
+		int mScore; //Twice the cost, plus the shared estimate.
+		int mCost;
+		int mIndex;
+
+		//Ties are broken towards the node furthest from where its search began, so the searches head for each other across open ground.
+		bool operator>(const SQueueEntry& other) const
+		{
+			return mScore > other.mScore || (mScore == other.mScore && mCost < other.mCost);
+		}
+	};
+
+	//The state of one of the two searches, indexed the same way as the TerrainMap.
+	//A square's cost and parent are only valid if its stamp is mStamp. A square is closed if its closed stamp is mStamp.
+	struct SDirection
+	{
+		vector<int> mCosts; //Forwards: the cost from the start to the square. Backwards: the cost from the square to the goal.
+		vector<int> mParents; //The square the search reached this one from.
+		vector<unsigned int> mStamps;
+		vector<unsigned int> mClosed;
+		priority_queue<SQueueEntry, vector<SQueueEntry>, greater<SQueueEntry>> mOpen;
+		int mTarget; //The end the search is heading for: the goal forwards, the start backwards.
+	};
+
+	static const int FORWARD = 0;
+	static const int BACKWARD = 1;
+
+	bool mWeighted; //True for A*. False for breadth first.
+	SMovementRules mMovement;
+	SDirection mDirections[2];
+	unsigned int mStamp = 0;
+	int mStartIndex = 0;
+	int mGoalIndex = 0;
+	int mBestCost = 0; //The cost of the cheapest path through a square both searches have reached.
+	int mMeeting = -1; //The square that path goes through.
+
+	//Resets both searches for a new query. Returns false if the goal can't be reached.
+	bool Start(const TerrainMap& terrain, int startIndex, int goalIndex);
+
+	//Removes the out of date entries from the front of a search's open list.
+	void SkipStale(SDirection& direction);
+
+	//Expands the next node of whichever search has the smaller open list. Returns the square expanded, or -1 if the search has finished.
+	int Expand(const TerrainMap& terrain, EStepPathResults& result);
+
+	//Lowers the cost of a square in one search, if the new cost is cheaper, and checks whether it is now a cheaper meeting.
+	void Relax(const TerrainMap& terrain, int side, int index, int parent, int cost);
+
+	//The Manhattan (or octile) distance from the square to the end the search is heading for. 0 for breadth first.
+	int Heuristic(const TerrainMap& terrain, int side, int index) const;
+
+	//Joins the two halves of the path at the meeting square.
+	void BuildPath(const TerrainMap& terrain, NodeList& path) const;
+
+	//The memory held by the arrays of both searches.
+	long long ScratchBytes() const;
+
+public:
+	//If weighted is false the searches are breadth first, counting steps instead of terrain costs.
+	CSearchBidirectional(bool weighted, const SMovementRules& movement = SMovementRules());
+
+	// Constructs the path from start to goal for the given terrain
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+
+	// Each step expands one node from one of the searches, and adds it to the closed list.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
+};
@@ -11,7 +11,7 @@
 // This function takes ownership of the start and goal pointers that are passed in from the calling code.
 // Ownership is not returned at the end, so the start and goal nodes are consumed.
 // The Path is returned through the reference parameter.
-bool CSearchBreadthFirst::FindPath(TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+bool CSearchBreadthFirst::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
 {
 	NodeList openList;
 	NodeList closedList;
@@ -36,8 +36,26 @@ bool CSearchBreadthFirst::FindPath(TerrainMap& terrain, unique_ptr<SNode> start,
 // Performs the function of the loop in FindPath. Start should be the first node in openlist the first time StepPath is called.
 // Takes the openlist and closedlist as additionally reference parameters; These are used to set textures and create models.
 // Goal is passed as a reference parameter because it is used for comparison; It is not added onto the openlist until it is found by the search.
-EStepPathResults CSearchBreadthFirst::StepPath(TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+EStepPathResults CSearchBreadthFirst::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
 {
+	//The closed list is only empty on the first step of a search, when the open list holds the start node.
+	//Reset the cell states and record the nodes the caller placed on the open list.
+	if (closedList.empty())
+	{
+		StartStats();
+		mStats.mEpsilon = 0.0; //The fewest steps, not the cheapest, so there is no bound on the cost.
+		if (!CanReachGoal(terrain, openList, goal.get(), mMovement))
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+		mSearchState.Reset(terrain);
+		for (auto it = openList.begin(); it != openList.end(); it++)
+		{
+			mSearchState.Open((*it).get(), 0);
+		}
+		mStats.mNodesGenerated = openList.size();
+	}
 
 	//Pop the first element from OpenList.
 	unique_ptr<SNode> current = move(openList.front());
@@ -48,81 +66,44 @@ EStepPathResults CSearchBreadthFirst::StepPath(TerrainMap& terrain, NodeList& op
 	if (current->NodesMatch(goal.get()))
 	{
 		BuildPath(path, closedList, move(current));
+		FinishStats();
 		return EStepPathResults::PATH_FOUND;
 	}
 
 	unique_ptr<SNode> tmp; // So new unique_ptrs don't need to be defined each time a new node is created
+	int index = terrain.Index(current->x, current->y); //The position of the current node in the terrain and the search state.
+	int neighbour; //The position of the neighbour being tested.
+	int steps = mSearchState.Cell(index).mCost; //The number of steps from the start to the current node.
 
-	//NORTH. Test if in open, closed or wall.
-	if (current->y + 1 < terrain[0].size()) //Ensure that it is within the bounds of the map. EG, in a 10 by 10 map, if y + 1 = 10, not valid.
-	{
-		if (terrain[current->x][current->y + 1] != ENodeType::wall //Is not a wall
-			&& !IsNodeOnList(openList, current->x, current->y + 1) //Is not on the open list
-			&& !IsNodeOnList(closedList, current->x, current->y + 1)) //Is not on the closed list
-		{
-			//Set up the node data, then move onto the open list.
-			tmp.reset(new SNode);
-			tmp->x = current->x;
-			tmp->y = current->y + 1;
-			tmp->mpParent = current.get();
-
-			openList.push_back(move(tmp));
-		}
-	}
-	//East
-	if (current->x + 1 < terrain.size())
-	{
-		if (terrain[current->x + 1][current->y] != ENodeType::wall //Is not a wall
-			&& !IsNodeOnList(openList, current->x + 1, current->y) //Is not on the open list
-			&& !IsNodeOnList(closedList, current->x + 1, current->y)) //Is not on the closed list
-		{
-			//Set up the node data, then move onto the open list.
-			tmp.reset(new SNode);
-			tmp->x = current->x + 1;
-			tmp->y = current->y;
-			tmp->mpParent = current.get();
-
-			openList.push_back(move(tmp));
-		}
-	}
-	//SOUTH. Test if in open, closed or wall.
-	if (current->y - 1 >= 0) //Ensure that it is within the bounds of the map. EG, in a 10 by 10 map, if y + 1 = 10, not valid.
-	{
-		if (terrain[current->x][current->y - 1] != ENodeType::wall //Is not a wall
-			&& !IsNodeOnList(openList, current->x, current->y - 1) //Is not on the open list
-			&& !IsNodeOnList(closedList, current->x, current->y - 1)) //Is not on the closed list
-		{
-			//Set up the node data, then move onto the open list.
-			tmp.reset(new SNode);
-			tmp->x = current->x;
-			tmp->y = current->y - 1;
-			tmp->mpParent = current.get();
-
-			openList.push_back(move(tmp));
-		}
-	}
-	//West
-	if (current->x - 1 >= 0)
+	//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+	//North, east, south and west, then the diagonals if the movement allows them. Test if in open, closed or wall.
+	for (int direction = 0; direction < mMovement.NumDirections(); direction++)
 	{
-		if (terrain[current->x - 1][current->y] != ENodeType::wall //Is not a wall
-			&& !IsNodeOnList(openList, current->x - 1, current->y) //Is not on the open list
-			&& !IsNodeOnList(closedList, current->x - 1, current->y)) //Is not on the closed list
+		neighbour = index + SMovementRules::Offset(terrain, direction);
+		if (mMovement.CanMove(terrain, index, direction) //Is not a wall, or a corner that can't be cut
+			&& mSearchState.Cell(neighbour).mStatus == ENodeStatus::Unvisited) //Is not on the open or closed list
 		{
 			//Set up the node data, then move onto the open list.
 			tmp.reset(new SNode);
-			tmp->x = current->x - 1;
-			tmp->y = current->y;
+			tmp->x = current->x + MOVE_DX[direction];
+			tmp->y = current->y + MOVE_DY[direction];
 			tmp->mpParent = current.get();
 
+			mSearchState.Open(tmp.get(), steps + 1);
 			openList.push_back(move(tmp));
+			mStats.mNodesGenerated++;
 		}
 	}
 
+	mSearchState.Close(current.get());
 	closedList.push_back(move(current));
+	mStats.mNodesExpanded++;
+	UpdatePeaks(openList.size(), closedList.size());
 
 	//If the open list is empty, no path exists. If 
 	if (openList.empty())
 	{
+		FinishStats();
 		return EStepPathResults::NO_PATH;
 	}
 	else
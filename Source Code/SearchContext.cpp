@@ -0,0 +1,70 @@
+//Leo Croft
+
+// SearchContext.cpp
+// =================
+//
+// Implementation of a query that can be run a few steps at a time
+//
+
+#include "SearchContext.h" // Declaration of this class
+
+//Begins a new query, abandoning any query in progress. No steps are run until Run is called.
+void CSearchContext::Start(ISearch& search, const TerrainMap& terrain, SIntVector start, SIntVector goal)
+{
+	mpSearch = &search;
+	mpTerrain = &terrain;
+	mOpenList.clear();
+	mClosedList.clear();
+	mPath.clear();
+
+	//The searches don't check the bounds, so queries off the map are answered here.
+	if (!terrain.InBounds(start.x, start.y) || !terrain.InBounds(goal.x, goal.y))
+	{
+		mpGoal.reset();
+		mResult = EStepPathResults::NO_PATH;
+		mRunning = false;
+		return;
+	}
+
+	//StepPath starts a new search when the closed list is empty, from the nodes on the open list.
+	mOpenList.push_back(unique_ptr<SNode>(new SNode{ start.x, start.y, 0 }));
+	mpGoal.reset(new SNode{ goal.x, goal.y, 0 });
+	mResult = EStepPathResults::STEP_SUCCESS;
+	mRunning = true;
+}
+
+//Runs one step, and records the result if the query has finished.
+void CSearchContext::Step()
+{
+	mResult = mpSearch->StepPath(*mpTerrain, mOpenList, mClosedList, mpGoal, mPath);
+	if (mResult != EStepPathResults::STEP_SUCCESS)
+	{
+		mRunning = false;
+		if (mResult == EStepPathResults::NO_PATH)
+		{
+			mPath.clear(); //Some searches leave bookkeeping nodes in the path when they fail.
+		}
+	}
+}
+
+EStepPathResults CSearchContext::Run(int maxSteps)
+{
+	for (int i = 0; i < maxSteps && mRunning; i++)
+	{
+		Step();
+	}
+	return mResult;
+}
+
+EStepPathResults CSearchContext::Run(chrono::steady_clock::time_point deadline)
+{
+	for (int steps = 1; mRunning; steps++)
+	{
+		Step();
+		if (steps % SEARCH_CONTEXT_CLOCK_INTERVAL == 0 && chrono::steady_clock::now() >= deadline)
+		{
+			break;
+		}
+	}
+	return mResult;
+}
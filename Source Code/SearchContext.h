@@ -0,0 +1,80 @@
+//Leo Croft
+
+// SearchContext.h
+// ===============
+//
+// One query that can be run a few steps at a time, across many frames
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "Search.h" // Search interface
+#include <chrono>
+
+//When running to a deadline, the number of steps run between readings of the clock. Reading the clock costs about as much as a step of A*,
+//so it isn't read every step. A step of A* takes well under a microsecond, so the deadline is overrun by a few microseconds at most.
+const int SEARCH_CONTEXT_CLOCK_INTERVAL = 16;
+
+// Owns everything a query needs between calls to StepPath: the open and closed lists, the goal and the path.
+// Start a query, then call Run once a frame with a number of steps or a deadline, until it returns PATH_FOUND or NO_PATH.
+// A long search can then be spread across frames without stalling the render loop.
+//
+// A step is one call to StepPath, which is one node for most searches. D* Lite does its whole search in its first step, and the first step
+// of HPA* searches the whole abstract graph, so those can't be split up.
+// The search and the terrain are not owned. Neither can be used for anything else, or destroyed, until the query has finished.
+class CSearchContext
+{
+private:
+	ISearch* mpSearch = nullptr;
+	const TerrainMap* mpTerrain = nullptr;
+	NodeList mOpenList;
+	NodeList mClosedList;
+	unique_ptr<SNode> mpGoal;
+	NodeList mPath;
+	EStepPathResults mResult = EStepPathResults::NO_PATH;
+	bool mRunning = false;
+
+	//Runs one step, and records the result if the query has finished.
+	void Step();
+
+public:
+	//Begins a new query, abandoning any query in progress. No steps are run until Run is called.
+	//A start or goal off the map finishes the query straight away, with NO_PATH.
+	void Start(ISearch& search, const TerrainMap& terrain, SIntVector start, SIntVector goal);
+
+	//Runs up to maxSteps steps. Returns STEP_SUCCESS if the query hasn't finished, otherwise its result.
+	EStepPathResults Run(int maxSteps);
+
+	//Runs steps until the query finishes or the deadline has passed. At least one step is run, so every call makes progress.
+	//The clock is read every SEARCH_CONTEXT_CLOCK_INTERVAL steps. Returns the same as Run(maxSteps).
+	EStepPathResults Run(chrono::steady_clock::time_point deadline);
+
+	//True from Start until the query has finished.
+	bool Running() const
+	{
+		return mRunning;
+	}
+
+	//The lists of the query in progress, for displaying the search. Searches that keep their own lists fill these in differently; See StepPath.
+	const NodeList& GetOpenList() const
+	{
+		return mOpenList;
+	}
+	const NodeList& GetClosedList() const
+	{
+		return mClosedList;
+	}
+
+	//The path, once the query has finished with PATH_FOUND. It can be moved out; It is cleared by the next Start.
+	NodeList& GetPath()
+	{
+		return mPath;
+	}
+
+	//The statistics of the query in progress, or of the last one finished. Only call after Start.
+	const SSearchStats& GetStats() const
+	{
+		return mpSearch->GetStats();
+	}
+};
@@ -0,0 +1,389 @@
+//Leo Croft
+
+// SearchDStarLite.cpp
+// ===================
+//
+// Implementation of Search class for the D* Lite algorithm
+//
+
+#include "SearchDStarLite.h" // Declaration of this class
+#include <algorithm>
+#include <climits>
+
+const int DSTAR_INFINITY = INT_MAX / 2; //The cost of squares with no route to the goal. Small enough that adding a terrain cost can't overflow.
+
+CSearchDStarLite::CSearchDStarLite(const SMovementRules& movement) : mMovement(movement)
+{
+}
+
+//Returns true if entry a should come after entry b in the queue, for use with the heap functions.
+bool CSearchDStarLite::QueueEntryAfter(const SQueueEntry& a, const SQueueEntry& b)
+{
+	return (a.mKey1 != b.mKey1) ? a.mKey1 > b.mKey1 : a.mKey2 > b.mKey2;
+}
+
+//Returns true if key a is smaller than key b.
+static bool KeyLess(int a1, int a2, int b1, int b2)
+{
+	return (a1 != b1) ? a1 < b1 : a2 < b2;
+}
+
+//Empties the state and starts a new search towards the goal.
+void CSearchDStarLite::Initialise(const TerrainMap& terrain, int startIndex, int goalIndex)
+{
+	SDStarCell empty = { DSTAR_INFINITY, DSTAR_INFINITY, 0, 0, false };
+	mCells.assign(terrain.Size(), empty);
+	mQueue.clear();
+	mQueuedCount = 0;
+
+	mTerrain.resize(terrain.Size());
+	for (int i = 0; i < terrain.Size(); i++)
+	{
+		mTerrain[i] = terrain[i];
+	}
+	mMapId = terrain.GetId();
+	mMapVersion = terrain.GetVersion();
+	mStride = terrain.GetStride();
+	mStartIndex = startIndex;
+	mGoalIndex = goalIndex;
+	mKeyModifier = 0;
+
+	//The search starts from the goal.
+	mCells[goalIndex].mRhs = 0;
+	UpdateCell(goalIndex);
+}
+
+//Manhattan (or octile) distance from the start, the lowest possible cost of a route between them.
+int CSearchDStarLite::Heuristic(int index)
+{
+	return mMovement.Distance(index % mStride - mStartIndex % mStride, index / mStride - mStartIndex / mStride);
+}
+
+//Calculates the priority of a square. Compares on key1 and then key2.
+void CSearchDStarLite::CalculateKey(int index, int& key1, int& key2)
+{
+	key2 = min(mCells[index].mG, mCells[index].mRhs);
+	key1 = (key2 == DSTAR_INFINITY) ? DSTAR_INFINITY : key2 + Heuristic(index) + mKeyModifier;
+}
+
+//The cheapest route to the goal through any of the square's neighbours.
+int CSearchDStarLite::CalculateRhs(const TerrainMap& terrain, int index)
+{
+	if (index == mGoalIndex)
+	{
+		return 0;
+	}
+	if (terrain[index] == ENodeType::wall)
+	{
+		return DSTAR_INFINITY;
+	}
+
+	//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+	int best = DSTAR_INFINITY;
+	for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+	{
+		int neighbour = index + SMovementRules::Offset(terrain, direction);
+		if (mMovement.CanMove(terrain, index, direction) && mCells[neighbour].mG != DSTAR_INFINITY)
+		{
+			best = min(best, mCells[neighbour].mG + mMovement.MoveCost(terrain, neighbour, direction));
+		}
+	}
+	return best;
+}
+
+//Queues the square if its g and rhs differ, otherwise takes it off the queue.
+void CSearchDStarLite::UpdateCell(int index)
+{
+	SDStarCell& cell = mCells[index];
+	if (cell.mG != cell.mRhs)
+	{
+		int key1;
+		int key2;
+		CalculateKey(index, key1, key2);
+		if (!cell.mQueued || cell.mKey1 != key1 || cell.mKey2 != key2)
+		{
+			if (!cell.mQueued)
+			{
+				mQueuedCount++;
+			}
+			cell.mQueued = true;
+			cell.mKey1 = key1;
+			cell.mKey2 = key2;
+			mQueue.push_back({ key1, key2, index });
+			push_heap(mQueue.begin(), mQueue.end(), QueueEntryAfter);
+			mStats.mNodesGenerated++;
+		}
+	}
+	else if (cell.mQueued)
+	{
+		cell.mQueued = false;
+		mQueuedCount--;
+	}
+}
+
+//Removes stale entries from the front of the queue. Returns false if the queue is empty.
+bool CSearchDStarLite::CleanQueueFront()
+{
+	//If most of the heap is stale, rebuild it from the entries that are still valid rather than popping them one at a time.
+	if (int(mQueue.size()) > 4 * mQueuedCount + 1024)
+	{
+		vector<SQueueEntry> valid;
+		valid.reserve(mQueuedCount);
+		for (auto it = mQueue.begin(); it != mQueue.end(); it++)
+		{
+			SDStarCell& cell = mCells[it->mIndex];
+			if (cell.mQueued && cell.mKey1 == it->mKey1 && cell.mKey2 == it->mKey2)
+			{
+				valid.push_back(*it);
+				cell.mQueued = false; //Cleared so a square queued twice with the same key is only kept once.
+			}
+		}
+		for (auto it = valid.begin(); it != valid.end(); it++)
+		{
+			mCells[it->mIndex].mQueued = true;
+		}
+		mQueue.swap(valid);
+		make_heap(mQueue.begin(), mQueue.end(), QueueEntryAfter);
+	}
+
+	while (!mQueue.empty())
+	{
+		const SQueueEntry& top = mQueue.front();
+		const SDStarCell& cell = mCells[top.mIndex];
+		if (cell.mQueued && cell.mKey1 == top.mKey1 && cell.mKey2 == top.mKey2)
+		{
+			return true;
+		}
+		pop_heap(mQueue.begin(), mQueue.end(), QueueEntryAfter);
+		mQueue.pop_back();
+	}
+	return false;
+}
+
+//Processes squares until the start's route is known to be the cheapest.
+void CSearchDStarLite::ComputeShortestPath(const TerrainMap& terrain)
+{
+	while (CleanQueueFront())
+	{
+		SQueueEntry top = mQueue.front();
+		int startKey1;
+		int startKey2;
+		CalculateKey(mStartIndex, startKey1, startKey2);
+		SDStarCell& start = mCells[mStartIndex];
+		if (!KeyLess(top.mKey1, top.mKey2, startKey1, startKey2) && start.mRhs <= start.mG)
+		{
+			break;
+		}
+
+		int index = top.mIndex;
+		SDStarCell& cell = mCells[index];
+		int key1;
+		int key2;
+		CalculateKey(index, key1, key2);
+
+		if (KeyLess(top.mKey1, top.mKey2, key1, key2))
+		{
+			//The key is out of date because the start has moved. Queue it again with the new key.
+			UpdateCell(index);
+		}
+		else if (cell.mG > cell.mRhs)
+		{
+			//A cheaper route has been found. Fix the square and let its neighbours use it.
+			mStats.mNodesExpanded++;
+			cell.mG = cell.mRhs;
+			cell.mQueued = false;
+			mQueuedCount--;
+			//Moves are reversible, so the squares that can move onto this one are the ones it can move onto.
+			for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+			{
+				int neighbour = index + SMovementRules::Offset(terrain, direction);
+				if (mMovement.CanMove(terrain, index, direction) && neighbour != mGoalIndex)
+				{
+					mCells[neighbour].mRhs = min(mCells[neighbour].mRhs, cell.mG + mMovement.MoveCost(terrain, index, direction));
+					UpdateCell(neighbour);
+				}
+			}
+		}
+		else
+		{
+			//The route has got more expensive. Forget it, and recalculate the neighbours that were using it.
+			//The square is queued again once its new cost is known.
+			mStats.mNodesExpanded++;
+			mStats.mReopenings++;
+			int oldG = cell.mG;
+			cell.mG = DSTAR_INFINITY;
+			for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+			{
+				int neighbour = index + SMovementRules::Offset(terrain, direction);
+				if (mMovement.CanMove(terrain, index, direction) && neighbour != mGoalIndex && mCells[neighbour].mRhs == oldG + mMovement.MoveCost(terrain, index, direction))
+				{
+					mCells[neighbour].mRhs = CalculateRhs(terrain, neighbour);
+					UpdateCell(neighbour);
+				}
+			}
+			cell.mRhs = CalculateRhs(terrain, index);
+			UpdateCell(index);
+		}
+		UpdatePeaks(mQueue.size(), 0);
+	}
+}
+
+//Recalculates the squares affected by a change to the terrain of the square.
+void CSearchDStarLite::CellChanged(const TerrainMap& terrain, int index)
+{
+	mTerrain[index] = terrain[index];
+	mCells[index].mRhs = CalculateRhs(terrain, index);
+	UpdateCell(index);
+
+	//The cost of moving onto the square has changed for each of its neighbours. Without cutting corners, a wall also blocks the diagonal
+	//moves between the squares either side of it, which are all neighbours of it too.
+	for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+	{
+		int neighbour = index + SMovementRules::Offset(terrain, direction);
+		if (terrain[neighbour] != ENodeType::wall)
+		{
+			mCells[neighbour].mRhs = CalculateRhs(terrain, neighbour);
+			UpdateCell(neighbour);
+		}
+	}
+}
+
+//Tells the search which squares have changed since the last call, so they can be repaired without looking at the rest of the map.
+void CSearchDStarLite::UpdateCells(const TerrainMap& terrain, const vector<SIntVector>& changed)
+{
+	if (mGoalIndex == -1 || terrain.GetId() != mMapId || terrain.Size() != int(mCells.size()) || terrain.GetStride() != mStride)
+	{
+		return;
+	}
+
+	//The statistics belong to the last query, so the squares queued here aren't counted in them.
+	SSearchStats lastQuery = mStats;
+	for (auto it = changed.begin(); it != changed.end(); it++)
+	{
+		if (terrain.InBounds(it->x, it->y))
+		{
+			int index = terrain.Index(it->x, it->y);
+			if (mTerrain[index] != terrain[index])
+			{
+				CellChanged(terrain, index);
+			}
+		}
+	}
+	mStats = lastQuery;
+
+	//Each change to a square moves the version on by one. If fewer squares were given than that, some changes were missed,
+	//so the version is left for FindPath to find the rest.
+	if (changed.size() >= terrain.GetVersion() - mMapVersion)
+	{
+		mMapVersion = terrain.GetVersion();
+	}
+}
+
+// This function takes ownership of the start and goal pointers that are passed in from the calling code.
+// Ownership is not returned at the end, so the start and goal nodes are consumed.
+// The Path is returned through the reference parameter.
+bool CSearchDStarLite::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+{
+	int startIndex = terrain.Index(start->x, start->y);
+	int goalIndex = terrain.Index(goal->x, goal->y);
+
+	StartStats();
+	if (!mMovement.CanReach(terrain, startIndex, goalIndex))
+	{
+		FinishStats();
+		return false;
+	}
+
+	if (goalIndex != mGoalIndex || terrain.GetId() != mMapId || terrain.Size() != int(mCells.size()) || terrain.GetStride() != mStride)
+	{
+		Initialise(terrain, startIndex, goalIndex);
+	}
+	else
+	{
+		//The map has changed without UpdateCells being told about it, so find the changes by comparing against the copy.
+		if (terrain.GetVersion() != mMapVersion)
+		{
+			for (int i = 0; i < terrain.Size(); i++)
+			{
+				if (mTerrain[i] != terrain[i])
+				{
+					CellChanged(terrain, i);
+				}
+			}
+			mMapVersion = terrain.GetVersion();
+		}
+
+		//The keys are based on the distance from the start. When the start moves, every key could be too high by up to the distance moved,
+		//so that is added to the keys of squares queued from now on instead of updating the whole queue.
+		if (startIndex != mStartIndex)
+		{
+			mKeyModifier += Heuristic(startIndex);
+			mStartIndex = startIndex;
+		}
+	}
+
+	ComputeShortestPath(terrain);
+
+	if (mCells[startIndex].mRhs == DSTAR_INFINITY)
+	{
+		FinishStats();
+		return false;
+	}
+
+	//Follow the cheapest neighbour from the start to the goal. Every square can only be visited once, which guards against a loop.
+	path.push_back(move(start));
+	int index = startIndex;
+	for (int steps = 0; index != goalIndex && steps < terrain.Size(); steps++)
+	{
+		int best = -1;
+		int bestCost = DSTAR_INFINITY;
+		for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+		{
+			int neighbour = index + SMovementRules::Offset(terrain, direction);
+			if (mMovement.CanMove(terrain, index, direction) && mCells[neighbour].mG != DSTAR_INFINITY &&
+				mCells[neighbour].mG + mMovement.MoveCost(terrain, neighbour, direction) < bestCost)
+			{
+				best = neighbour;
+				bestCost = mCells[neighbour].mG + mMovement.MoveCost(terrain, neighbour, direction);
+			}
+		}
+		if (best == -1)
+		{
+			path.clear();
+			FinishStats();
+			return false;
+		}
+
+		index = best;
+		path.push_back(unique_ptr<SNode>(new SNode));
+		path.back()->x = terrain.IndexToX(index);
+		path.back()->y = terrain.IndexToY(index);
+		path.back()->mpParent = path[path.size() - 2].get();
+	}
+
+	FinishStats();
+	if (index != goalIndex)
+	{
+		path.clear();
+		return false;
+	}
+	return true;
+}
+
+// The search is repaired all at once rather than step by step, so the first step finds the path.
+EStepPathResults CSearchDStarLite::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+{
+	if (openList.empty())
+	{
+		return EStepPathResults::NO_PATH;
+	}
+
+	unique_ptr<SNode> start = move(openList.front());
+	openList.pop_front();
+	unique_ptr<SNode> goalCopy(new SNode{ goal->x, goal->y, 0 });
+	if (FindPath(terrain, move(start), move(goalCopy), path))
+	{
+		return EStepPathResults::PATH_FOUND;
+	}
+	return EStepPathResults::NO_PATH;
+}
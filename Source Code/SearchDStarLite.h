@@ -0,0 +1,100 @@
+//Leo Croft
+
+// SearchDStarLite.h
+// =================
+//
+// Declaration of Search class for the D* Lite algorithm (incremental replanning)
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include "Movement.h"     // Four or eight way movement
+
+// D* Lite searches backwards from the goal, keeping for every square the cost of its cheapest route to the goal (g),
+// and a one step lookahead of that cost from its neighbours (rhs). The state is kept between calls to FindPath, so when squares of the map change
+// only the squares whose routes pass through them are searched again, and the start can move (as an agent follows the path) without searching again.
+// A new goal, or a different map, starts the search from scratch.
+//
+// Tell the search which squares changed with UpdateCells for the cost of a replan to depend only on the size of the change.
+// If the map has changed without UpdateCells being called, FindPath compares the whole map against its copy to find the changes.
+class CSearchDStarLite : public ISearch
+{
+private:
+	//The state of one square. Indexed the same way as the TerrainMap.
+	struct SDStarCell
+	{
+		int mG; //Cost of the cheapest route to the goal found so far.
+		int mRhs; //The cheapest of the neighbours' routes plus the cost of moving onto them.
+		int mKey1; //The key the square was last queued with, if mQueued.
+		int mKey2;
+		bool mQueued;
+	};
+
+	//An entry in the priority queue. Entries are not removed when a square's key changes; Entries that no longer match the square are skipped.
+	struct SQueueEntry
+	{
+		int mKey1;
+		int mKey2;
+		int mIndex;
+	};
+
+	SMovementRules mMovement;
+	vector<SDStarCell> mCells;
+	vector<SQueueEntry> mQueue; //A binary heap, smallest key at the front.
+	int mQueuedCount = 0; //The number of squares with mQueued set. mQueue may hold more entries than this.
+	vector<uint8_t> mTerrain; //Copy of the terrain the state was built for, used to find changes that weren't passed to UpdateCells.
+	unsigned int mMapId = 0;
+	unsigned int mMapVersion = 0;
+	int mStride = 0;
+	int mStartIndex = -1;
+	int mGoalIndex = -1;
+	int mKeyModifier = 0; //Added to keys as the start moves, so queued keys stay valid (km in the D* Lite paper).
+
+	long long ScratchBytes() const
+	{
+		return mCells.capacity() * sizeof(SDStarCell) + mQueue.capacity() * sizeof(SQueueEntry) + mTerrain.capacity();
+	}
+
+	//Returns true if entry a should come after entry b in the queue, for use with the heap functions.
+	static bool QueueEntryAfter(const SQueueEntry& a, const SQueueEntry& b);
+
+	//Empties the state and starts a new search towards the goal.
+	void Initialise(const TerrainMap& terrain, int startIndex, int goalIndex);
+
+	//Manhattan (or octile) distance from the start, the lowest possible cost of a route between them.
+	int Heuristic(int index);
+
+	//Calculates the priority of a square. Compares on key1 and then key2.
+	void CalculateKey(int index, int& key1, int& key2);
+
+	//The cheapest route to the goal through any of the square's neighbours.
+	int CalculateRhs(const TerrainMap& terrain, int index);
+
+	//Queues the square if its g and rhs differ, otherwise takes it off the queue.
+	void UpdateCell(int index);
+
+	//Removes stale entries from the front of the queue. Returns false if the queue is empty.
+	bool CleanQueueFront();
+
+	//Processes squares until the start's route is known to be the cheapest.
+	void ComputeShortestPath(const TerrainMap& terrain);
+
+	//Recalculates the squares affected by a change to the terrain of the square.
+	void CellChanged(const TerrainMap& terrain, int index);
+
+public:
+	CSearchDStarLite(const SMovementRules& movement = SMovementRules());
+
+	//Tells the search which squares have changed since the last call, so they can be repaired without looking at the rest of the map.
+	//Changes to a map other than the one last searched are ignored; It will be searched from scratch.
+	//If fewer squares are given than the map has had changes since the last call, FindPath still compares the map to find the rest.
+	void UpdateCells(const TerrainMap& terrain, const vector<SIntVector>& changed);
+
+	// Constructs the path from start to goal for the given terrain, reusing the previous search where possible.
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+
+	// The search is repaired all at once rather than step by step, so the first step finds the path.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
+};
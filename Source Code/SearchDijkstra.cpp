@@ -0,0 +1,12 @@
+//Leo Croft
+
+// SearchDijkstra.cpp
+// ==================
+//
+// Instantiation of the search kernel for Dijkstra's algorithm
+//
+
+#include "SearchDijkstra.h" // Declaration of this class
+
+template class CSearchKernel<SFourConnected, CZeroHeuristic, CBucketOpenList>;
+template class CSearchKernel<SEightConnected, CZeroHeuristic, CBucketOpenList>;
@@ -0,0 +1,27 @@
+//Leo Croft
+
+// SearchDijkstra.h
+// ================
+//
+// Declaration of Search class for Dijkstra's algorithm
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "SearchKernel.h" // Dijkstra's algorithm is A* without the heuristic
+
+// Dijkstra search class definition
+
+// Expands nodes in order of their cost from the start alone, so it searches evenly in every direction.
+// The steps are the same as A* with a heuristic of 0, so the kernel is used with a zero heuristic.
+// Costs from the start are small integers that grow by at most 3 per move, so the bucket queue is always the better open list.
+// To answer many queries from the same start, see CDistanceField instead.
+typedef CSearchKernel<SFourConnected, CZeroHeuristic, CBucketOpenList> CSearchDijkstra;
+
+// The same with eight way movement. Pass SEightConnected(cutCorners) to the constructor after the heuristic to allow cutting corners.
+typedef CSearchKernel<SEightConnected, CZeroHeuristic, CBucketOpenList> CSearchDijkstraEightWay;
+
+// Compiled once, in SearchDijkstra.cpp.
+extern template class CSearchKernel<SFourConnected, CZeroHeuristic, CBucketOpenList>;
+extern template class CSearchKernel<SEightConnected, CZeroHeuristic, CBucketOpenList>;
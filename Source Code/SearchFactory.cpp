@@ -7,28 +7,112 @@
 //
 
 #include "SearchBreadthFirst.h"
+#include "SearchDijkstra.h"
 #include "SearchAStar.h"
-
-/* TODO - include each implemented search class here */
-
+#include "SearchDStarLite.h"
+#include "SearchHPAStar.h"
+#include "SearchBidirectional.h"
+#include "SearchJumpPoint.h"
+#include "SearchARAStar.h"
 
 #include "SearchFactory.h" // Factory declarations
 
 // Create new search object of the given type and return a pointer to it.
 // Note the returned pointer type is the base class. This is how we implement polymorphism.
-ISearch* NewSearch(ESearchType search)
+ISearch* NewSearch(ESearchType search, const CLandmarks* landmarks, const SMovementRules& movement, int clusterSize)
 {
+  bool eightWay = (movement.mMovement == EMovement::EightWay);
   switch (search)
   {
 	case BreadthFirst:
 	{
-		return new CSearchBreadthFirst();
+		return new CSearchBreadthFirst(movement);
+	}
+	case Dijkstra:
+	{
+		if (eightWay)
+		{
+			return new CSearchDijkstraEightWay(CZeroHeuristic(), SEightConnected(movement.mCutCorners));
+		}
+		return new CSearchDijkstra();
 	}
 	case AStar:
 	{
+		if (eightWay)
+		{
+			return new CSearchAStarEightWay(COctileHeuristic(), SEightConnected(movement.mCutCorners));
+		}
+		//The landmark heuristic costs a few table lookups per node, so the plain kernel is used when there are no landmarks.
+		if (landmarks != nullptr)
+		{
+			return new CSearchAStarLandmarks(CLandmarkHeuristic(landmarks));
+		}
 		return new CSearchAStar();
 	}
-    /* TODO - add a case for each implemented search type here */
-
+	case AStarBuckets:
+	{
+		if (eightWay)
+		{
+			return new CSearchAStarBucketsEightWay(COctileHeuristic(), SEightConnected(movement.mCutCorners));
+		}
+		if (landmarks != nullptr)
+		{
+			return new CSearchAStarBucketsLandmarks(CLandmarkHeuristic(landmarks));
+		}
+		return new CSearchAStarBuckets();
+	}
+	case DStarLite:
+	{
+		return new CSearchDStarLite(movement);
+	}
+	case HPAStar:
+	{
+		//The abstract graph only crosses cluster borders between squares facing each other, which misses paths that cut a corner across one.
+		if (eightWay && movement.mCutCorners)
+		{
+			return new CSearchAStarEightWay(COctileHeuristic(), SEightConnected(true));
+		}
+		return new CSearchHPAStar((clusterSize > 0) ? clusterSize : HPA_DEFAULT_CLUSTER_SIZE, movement);
+	}
+	case BidirectionalBreadthFirst:
+	{
+		return new CSearchBidirectional(false, movement);
+	}
+	case BidirectionalAStar:
+	{
+		return new CSearchBidirectional(true, movement);
+	}
+	case JumpPoint:
+	{
+		//The jumps rely on only moving in four directions.
+		if (eightWay)
+		{
+			return new CSearchAStarEightWay(COctileHeuristic(), SEightConnected(movement.mCutCorners));
+		}
+		return new CSearchJumpPoint();
+	}
+	case ARAStar:
+	{
+		return new CSearchARAStar(ARA_INITIAL_EPSILON, ARA_EPSILON_STEP, movement);
+	}
+	default:
+	{
+		//NumOfSearches isn't a search.
+		return nullptr;
+	}
   }
 }
+
+//Finds the search type with the given name (see SEARCH_TYPE_NAMES). Returns false if there isn't one.
+bool SearchTypeFromName(const string& name, ESearchType& search)
+{
+	for (int i = 0; i < ESearchType::NumOfSearches; i++)
+	{
+		if (SEARCH_TYPE_NAMES[i] == name)
+		{
+			search = ESearchType(i);
+			return true;
+		}
+	}
+	return false;
+}
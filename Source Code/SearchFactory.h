@@ -9,18 +9,40 @@
 #pragma once
 
 #include "Search.h" // Search interface class
+#include "Movement.h" // Four or eight way movement
+#include <string>
+
+class CLandmarks;
 
 // List of implemented seach algorithms
 enum ESearchType
 {
   BreadthFirst,
-  //Dijkstra,
+  Dijkstra,
   AStar,
-  
-  /* TODO - Add type elements for each implemented search */
+  AStarBuckets, //A* using a bucket queue instead of a heap for the open list.
+  DStarLite, //Keeps its search between calls, and repairs it when the map or start changes.
+  HPAStar, //Searches a precomputed graph of clusters of the map. Much faster on large maps, but paths may cost slightly more than the cheapest.
+  BidirectionalBreadthFirst, //Breadth first from both ends at once.
+  BidirectionalAStar, //A* from both ends at once.
+  JumpPoint, //A* that jumps across clear terrain, only stopping where a path could have to turn (JPS4).
+  ARAStar, //Anytime A*: finds a path quickly with a weighted heuristic, then improves it until a deadline. See CSearchARAStar::SetDeadline.
 
   NumOfSearches //The number of available searches, to remove magic numbers
 };
 
-// Factory function to create CSearchXXX object where XXX is the given search type
-ISearch* NewSearch(ESearchType search);
+//Names used to pick a search on the command line, and in the output of the tools. Keep in the same order as ESearchType.
+const string SEARCH_TYPE_NAMES[ESearchType::NumOfSearches] = { "BreadthFirst", "Dijkstra", "AStar", "AStarBuckets", "DStarLite", "HPAStar", "BidirectionalBreadthFirst",
+	"BidirectionalAStar", "JumpPoint", "ARAStar" };
+
+// Factory function to create CSearchXXX object where XXX is the given search type. Returns nullptr for NumOfSearches.
+// The A* searches use the landmarks (see Landmarks.h) if they are given and match the map being searched. The other searches ignore them.
+// Every search follows the movement rules. The landmark bounds are four way costs, so they are ignored with eight way movement,
+// and jump point search only jumps in four directions, so with eight way movement it is replaced by A*. HPA* is replaced by A* too
+// when corners are cut (see SearchHPAStar.h).
+// clusterSize is the width of HPA*'s clusters in squares, or 0 for HPA_DEFAULT_CLUSTER_SIZE. Larger clusters make a smaller abstract graph,
+// but each search inside a cluster covers more squares.
+ISearch* NewSearch(ESearchType search, const CLandmarks* landmarks = nullptr, const SMovementRules& movement = SMovementRules(), int clusterSize = 0);
+
+//Finds the search type with the given name (see SEARCH_TYPE_NAMES). Returns false if there isn't one.
+bool SearchTypeFromName(const string& name, ESearchType& search);
@@ -0,0 +1,636 @@
+//Leo Croft
+
+// SearchHPAStar.cpp
+// =================
+//
+// Implementation of Search class for hierarchical path-finding (HPA*)
+//
+
+#include "SearchHPAStar.h" // Declaration of this class
+#include "DistanceField.h" // UNREACHABLE
+#include <queue>
+#include <functional>
+
+CSearchHPAStar::CSearchHPAStar(int clusterSize, const SMovementRules& movement) : mClusterSize(max(1, clusterSize)), mMovement(movement)
+{
+}
+
+int CSearchHPAStar::ClusterOf(const TerrainMap& terrain, int index) const
+{
+	return (terrain.IndexToY(index) / mClusterSize) * mClustersX + terrain.IndexToX(index) / mClusterSize;
+}
+
+//Builds the graph from scratch for a new map.
+void CSearchHPAStar::BuildGraph(const TerrainMap& terrain)
+{
+	mMapId = terrain.GetId();
+	mMapVersion = terrain.GetVersion();
+	mMapWidth = terrain.GetWidth();
+	mMapHeight = terrain.GetHeight();
+	mClustersX = (mMapWidth + mClusterSize - 1) / mClusterSize;
+	mClustersY = (mMapHeight + mClusterSize - 1) / mClusterSize;
+
+	mTerrain.resize(terrain.Size());
+	for (int i = 0; i < terrain.Size(); i++)
+	{
+		mTerrain[i] = terrain[i];
+	}
+	mEntranceSlot.assign(terrain.Size(), -1);
+	mAbstractCosts.assign(terrain.Size(), 0);
+	mAbstractParents.assign(terrain.Size(), -1);
+	mAbstractStamps.assign(terrain.Size(), 0);
+	mStamp = 0;
+
+	mClusters.assign(mClustersX * mClustersY, SCluster());
+	for (int y = 0; y < mClustersY; y++)
+	{
+		for (int x = 0; x < mClustersX; x++)
+		{
+			SCluster& cluster = mClusters[y * mClustersX + x];
+			cluster.mLeft = x * mClusterSize;
+			cluster.mBottom = y * mClusterSize;
+			cluster.mWidth = min(mClusterSize, mMapWidth - cluster.mLeft);
+			cluster.mHeight = min(mClusterSize, mMapHeight - cluster.mBottom);
+		}
+	}
+
+	for (int cluster = 0; cluster < int(mClusters.size()); cluster++)
+	{
+		FindTransitions(terrain, cluster, ECompass::East);
+		FindTransitions(terrain, cluster, ECompass::North);
+	}
+	for (int cluster = 0; cluster < int(mClusters.size()); cluster++)
+	{
+		BuildEntrances(terrain, cluster);
+	}
+}
+
+//Rebuilds the given clusters (whose terrain has changed), and the entrances of the clusters next to them.
+void CSearchHPAStar::RebuildClusters(const TerrainMap& terrain, const vector<int>& changed)
+{
+	//The borders of a changed cluster may have new transitions. Each border is stored by the cluster to the west or south of it.
+	vector<int> affected;
+	for (auto it = changed.begin(); it != changed.end(); it++)
+	{
+		int x = *it % mClustersX;
+		int y = *it / mClustersX;
+		FindTransitions(terrain, *it, ECompass::East);
+		FindTransitions(terrain, *it, ECompass::North);
+		affected.push_back(*it);
+		if (x > 0)
+		{
+			FindTransitions(terrain, *it - 1, ECompass::East);
+			affected.push_back(*it - 1);
+		}
+		if (y > 0)
+		{
+			FindTransitions(terrain, *it - mClustersX, ECompass::North);
+			affected.push_back(*it - mClustersX);
+		}
+		if (x + 1 < mClustersX)
+		{
+			affected.push_back(*it + 1);
+		}
+		if (y + 1 < mClustersY)
+		{
+			affected.push_back(*it + mClustersX);
+		}
+	}
+
+	//The clusters sharing those borders have new entrances, so the costs between their entrances are worked out again.
+	sort(affected.begin(), affected.end());
+	affected.erase(unique(affected.begin(), affected.end()), affected.end());
+	for (auto it = affected.begin(); it != affected.end(); it++)
+	{
+		BuildEntrances(terrain, *it);
+	}
+}
+
+//Finds the transitions along the east or north border of a cluster.
+void CSearchHPAStar::FindTransitions(const TerrainMap& terrain, int clusterIndex, ECompass border)
+{
+	SCluster& cluster = mClusters[clusterIndex];
+	vector<pair<int, int>>& transitions = (border == ECompass::East) ? cluster.mEastTransitions : cluster.mNorthTransitions;
+	transitions.clear();
+
+	//Clusters on the edge of the map have no neighbour on that side.
+	int length;
+	if (border == ECompass::East)
+	{
+		if (cluster.mLeft + cluster.mWidth >= mMapWidth)
+		{
+			return;
+		}
+		length = cluster.mHeight;
+	}
+	else
+	{
+		if (cluster.mBottom + cluster.mHeight >= mMapHeight)
+		{
+			return;
+		}
+		length = cluster.mWidth;
+	}
+
+	//The square at the given position along the border, on this side of it. The square facing it is one step further in the direction of the border.
+	auto BorderSquare = [&](int position)
+	{
+		return (border == ECompass::East) ? terrain.Index(cluster.mLeft + cluster.mWidth - 1, cluster.mBottom + position)
+			: terrain.Index(cluster.mLeft + position, cluster.mBottom + cluster.mHeight - 1);
+	};
+	int across = terrain.Offset(border);
+
+	//Find each run of squares that are open on both sides of the border.
+	int runStart = -1;
+	for (int position = 0; position <= length; position++)
+	{
+		bool open = false;
+		if (position < length)
+		{
+			int square = BorderSquare(position);
+			open = terrain[square] != ENodeType::wall && terrain[square + across] != ENodeType::wall;
+		}
+
+		if (open && runStart < 0)
+		{
+			runStart = position;
+		}
+		else if (!open && runStart >= 0)
+		{
+			int runEnd = position - 1;
+			if (runEnd - runStart + 1 < HPA_MAX_SINGLE_TRANSITION_WIDTH)
+			{
+				int middle = BorderSquare((runStart + runEnd) / 2);
+				transitions.push_back({ middle, middle + across });
+			}
+			else
+			{
+				transitions.push_back({ BorderSquare(runStart), BorderSquare(runStart) + across });
+				transitions.push_back({ BorderSquare(runEnd), BorderSquare(runEnd) + across });
+			}
+			runStart = -1;
+		}
+	}
+}
+
+//Collects the entrances of a cluster from the transitions on its four borders, and works out the costs between them.
+void CSearchHPAStar::BuildEntrances(const TerrainMap& terrain, int clusterIndex)
+{
+	SCluster& cluster = mClusters[clusterIndex];
+	for (auto it = cluster.mEntrances.begin(); it != cluster.mEntrances.end(); it++)
+	{
+		mEntranceSlot[*it] = -1;
+	}
+	cluster.mEntrances.clear();
+	cluster.mPartners.clear();
+
+	//A square at a corner of the cluster can be on two borders, so it is only added once.
+	auto AddTransition = [&cluster](int square, int partner)
+	{
+		auto found = find(cluster.mEntrances.begin(), cluster.mEntrances.end(), square);
+		int slot = found - cluster.mEntrances.begin();
+		if (found == cluster.mEntrances.end())
+		{
+			cluster.mEntrances.push_back(square);
+			cluster.mPartners.push_back(vector<int>());
+		}
+		cluster.mPartners[slot].push_back(partner);
+	};
+
+	for (auto it = cluster.mEastTransitions.begin(); it != cluster.mEastTransitions.end(); it++)
+	{
+		AddTransition(it->first, it->second);
+	}
+	for (auto it = cluster.mNorthTransitions.begin(); it != cluster.mNorthTransitions.end(); it++)
+	{
+		AddTransition(it->first, it->second);
+	}
+	if (clusterIndex % mClustersX > 0)
+	{
+		vector<pair<int, int>>& west = mClusters[clusterIndex - 1].mEastTransitions;
+		for (auto it = west.begin(); it != west.end(); it++)
+		{
+			AddTransition(it->second, it->first);
+		}
+	}
+	if (clusterIndex / mClustersX > 0)
+	{
+		vector<pair<int, int>>& south = mClusters[clusterIndex - mClustersX].mNorthTransitions;
+		for (auto it = south.begin(); it != south.end(); it++)
+		{
+			AddTransition(it->second, it->first);
+		}
+	}
+
+	int numEntrances = cluster.mEntrances.size();
+	for (int slot = 0; slot < numEntrances; slot++)
+	{
+		mEntranceSlot[cluster.mEntrances[slot]] = slot;
+	}
+
+	//One search from each entrance finds the costs to all of the others.
+	cluster.mCosts.assign(numEntrances * numEntrances, UNREACHABLE);
+	for (int from = 0; from < numEntrances; from++)
+	{
+		SearchCluster(terrain, cluster, cluster.mEntrances[from], -1);
+		for (int to = 0; to < numEntrances; to++)
+		{
+			cluster.mCosts[from * numEntrances + to] = LocalCost(terrain, cluster, cluster.mEntrances[to]);
+		}
+	}
+}
+
+//Dijkstra's algorithm from the source, without leaving the cluster.
+void CSearchHPAStar::SearchCluster(const TerrainMap& terrain, const SCluster& cluster, int source, int target, SSearchStats* stats)
+{
+	mLocalCosts.assign(cluster.mWidth * cluster.mHeight, UNREACHABLE);
+	mLocalParents.assign(cluster.mWidth * cluster.mHeight, -1);
+
+	priority_queue<SQueueEntry, vector<SQueueEntry>, greater<SQueueEntry>> openList;
+	mLocalCosts[(terrain.IndexToY(source) - cluster.mBottom) * cluster.mWidth + terrain.IndexToX(source) - cluster.mLeft] = 0;
+	openList.push({ 0, 0, source });
+	long long expanded = 0;
+	long long generated = 1;
+	long long peakOpen = 1;
+
+	while (!openList.empty())
+	{
+		SQueueEntry current = openList.top();
+		openList.pop();
+		if (current.mCost != LocalCost(terrain, cluster, current.mIndex))
+		{
+			continue; //A cheaper route to the square has been found since this entry was pushed.
+		}
+		if (current.mIndex == target)
+		{
+			break;
+		}
+		expanded++;
+
+		for (int direction = 0; direction < mMovement.NumDirections(); direction++)
+		{
+			int neighbour = current.mIndex + SMovementRules::Offset(terrain, direction);
+			int x = terrain.IndexToX(neighbour) - cluster.mLeft;
+			int y = terrain.IndexToY(neighbour) - cluster.mBottom;
+			if (!mMovement.CanMove(terrain, current.mIndex, direction) || x < 0 || y < 0 || x >= cluster.mWidth || y >= cluster.mHeight)
+			{
+				continue;
+			}
+
+			int newCost = current.mCost + mMovement.MoveCost(terrain, neighbour, direction);
+			int local = y * cluster.mWidth + x;
+			if (mLocalCosts[local] == UNREACHABLE || newCost < mLocalCosts[local])
+			{
+				mLocalCosts[local] = newCost;
+				mLocalParents[local] = current.mIndex;
+				openList.push({ newCost, newCost, neighbour });
+				generated++;
+			}
+		}
+		peakOpen = max(peakOpen, (long long)openList.size());
+	}
+
+	if (stats != nullptr)
+	{
+		stats->mNodesExpanded += expanded;
+		stats->mNodesGenerated += generated;
+		stats->mPeakOpenSize = max(stats->mPeakOpenSize, peakOpen);
+		stats->mPeakClosedSize = max(stats->mPeakClosedSize, expanded);
+	}
+}
+
+//The cost that SearchCluster found for the square, or UNREACHABLE.
+int CSearchHPAStar::LocalCost(const TerrainMap& terrain, const SCluster& cluster, int index) const
+{
+	return mLocalCosts[(terrain.IndexToY(index) - cluster.mBottom) * cluster.mWidth + terrain.IndexToX(index) - cluster.mLeft];
+}
+
+//Searches the abstract graph, and stores the abstract path in mWaypoints. Returns false if there is no path.
+bool CSearchHPAStar::FindAbstractPath(const TerrainMap& terrain, int startIndex, int goalIndex)
+{
+	mWaypoints.clear();
+	int startCluster = ClusterOf(terrain, startIndex);
+	int goalCluster = ClusterOf(terrain, goalIndex);
+	const SCluster& goalEntrances = mClusters[goalCluster];
+	const SCluster& startEntrances = mClusters[startCluster];
+
+	//Join the goal to the entrances of its cluster. Moving onto a square costs the same from any direction, so the cost of the route from an
+	//entrance to the goal is the cost of the route from the goal to the entrance, plus the goal's terrain, minus the entrance's.
+	//With eight way movement the first and last moves may differ in length, so it is only an estimate; The route is searched again when refined.
+	vector<int> goalCosts(goalEntrances.mEntrances.size(), UNREACHABLE);
+	SearchCluster(terrain, goalEntrances, goalIndex, -1, &mStats);
+	for (int slot = 0; slot < int(goalCosts.size()); slot++)
+	{
+		int entrance = goalEntrances.mEntrances[slot];
+		int cost = LocalCost(terrain, goalEntrances, entrance);
+		if (cost != UNREACHABLE)
+		{
+			goalCosts[slot] = cost + mMovement.MoveCost(terrain, goalIndex, ECompass::North) - mMovement.MoveCost(terrain, entrance, ECompass::North);
+		}
+	}
+
+	//Join the start to the entrances of its cluster, and directly to the goal if they share a cluster.
+	vector<int> startCosts(startEntrances.mEntrances.size(), UNREACHABLE);
+	SearchCluster(terrain, startEntrances, startIndex, -1, &mStats);
+	for (int slot = 0; slot < int(startCosts.size()); slot++)
+	{
+		startCosts[slot] = LocalCost(terrain, startEntrances, startEntrances.mEntrances[slot]);
+	}
+	int directCost = (startCluster == goalCluster) ? LocalCost(terrain, startEntrances, goalIndex) : UNREACHABLE;
+
+	//The scratch costs are only valid for squares stamped during this search, so they never need clearing.
+	mStamp++;
+	if (mStamp == 0)
+	{
+		mAbstractStamps.assign(mAbstractStamps.size(), 0);
+		mStamp = 1;
+	}
+
+	int goalX = terrain.IndexToX(goalIndex);
+	int goalY = terrain.IndexToY(goalIndex);
+	priority_queue<SQueueEntry, vector<SQueueEntry>, greater<SQueueEntry>> openList;
+	auto Relax = [&](int index, int cost, int parent)
+	{
+		if (cost == UNREACHABLE)
+		{
+			return;
+		}
+		if (mAbstractStamps[index] != mStamp || cost < mAbstractCosts[index])
+		{
+			mAbstractStamps[index] = mStamp;
+			mAbstractCosts[index] = cost;
+			mAbstractParents[index] = parent;
+			int heuristic = mMovement.Distance(terrain.IndexToX(index) - goalX, terrain.IndexToY(index) - goalY);
+			openList.push({ cost + heuristic, cost, index });
+			mStats.mNodesGenerated++;
+		}
+	};
+
+	Relax(startIndex, 0, -1);
+	long long expanded = 0;
+	while (!openList.empty())
+	{
+		SQueueEntry current = openList.top();
+		openList.pop();
+		if (current.mCost != mAbstractCosts[current.mIndex])
+		{
+			continue;
+		}
+
+		if (current.mIndex == goalIndex)
+		{
+			for (int index = goalIndex; index != -1; index = mAbstractParents[index])
+			{
+				mWaypoints.push_back(index);
+			}
+			reverse(mWaypoints.begin(), mWaypoints.end());
+			return true;
+		}
+
+		mStats.mNodesExpanded++;
+		expanded++;
+		UpdatePeaks(openList.size() + 1, expanded); //Including the current entry.
+		int cost = current.mCost;
+		int slot = mEntranceSlot[current.mIndex];
+		int clusterIndex = ClusterOf(terrain, current.mIndex);
+		const SCluster& cluster = mClusters[clusterIndex];
+
+		if (current.mIndex == startIndex)
+		{
+			for (int to = 0; to < int(startCosts.size()); to++)
+			{
+				Relax(startEntrances.mEntrances[to], cost + startCosts[to], startIndex);
+			}
+			if (directCost != UNREACHABLE)
+			{
+				Relax(goalIndex, cost + directCost, startIndex);
+			}
+		}
+		else if (slot >= 0)
+		{
+			int numEntrances = cluster.mEntrances.size();
+			for (int to = 0; to < numEntrances; to++)
+			{
+				if (to != slot && cluster.mCosts[slot * numEntrances + to] != UNREACHABLE)
+				{
+					Relax(cluster.mEntrances[to], cost + cluster.mCosts[slot * numEntrances + to], current.mIndex);
+				}
+			}
+			if (clusterIndex == goalCluster && goalCosts[slot] != UNREACHABLE)
+			{
+				Relax(goalIndex, cost + goalCosts[slot], current.mIndex);
+			}
+		}
+
+		//Cross the border to the squares facing this one. The start may be an entrance too.
+		if (slot >= 0)
+		{
+			const vector<int>& partners = cluster.mPartners[slot];
+			for (auto it = partners.begin(); it != partners.end(); it++)
+			{
+				Relax(*it, cost + mMovement.MoveCost(terrain, *it, ECompass::North), current.mIndex); //Any of the compass directions costs the same.
+			}
+		}
+	}
+
+	return false;
+}
+
+//Adds the squares of the next segment of the abstract path to the path.
+void CSearchHPAStar::RefineSegment(const TerrainMap& terrain, NodeList& path)
+{
+	int from = mWaypoints[mNextWaypoint - 1];
+	int to = mWaypoints[mNextWaypoint];
+	vector<int> squares;
+
+	int clusterIndex = ClusterOf(terrain, from);
+	if (clusterIndex != ClusterOf(terrain, to))
+	{
+		squares.push_back(to); //Segments between clusters are a single step across the border.
+	}
+	else
+	{
+		const SCluster& cluster = mClusters[clusterIndex];
+		SearchCluster(terrain, cluster, from, to, &mStats);
+		for (int square = to; square != from; square = mLocalParents[(terrain.IndexToY(square) - cluster.mBottom) * cluster.mWidth + terrain.IndexToX(square) - cluster.mLeft])
+		{
+			squares.push_back(square);
+		}
+		reverse(squares.begin(), squares.end());
+	}
+
+	for (auto it = squares.begin(); it != squares.end(); it++)
+	{
+		SNode* parent = path.back().get();
+		path.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(*it), terrain.IndexToY(*it), 0 }));
+		path.back()->mpParent = parent;
+	}
+}
+
+//Brings the graph up to date with the terrain.
+void CSearchHPAStar::PrepareGraph(const TerrainMap& terrain)
+{
+	if (mClusters.empty() || terrain.GetId() != mMapId || terrain.GetWidth() != mMapWidth || terrain.GetHeight() != mMapHeight)
+	{
+		BuildGraph(terrain);
+		return;
+	}
+	if (terrain.GetVersion() == mMapVersion)
+	{
+		return;
+	}
+
+	//The map has changed without UpdateCells being told about it, so find the changed clusters by comparing against the copy.
+	vector<int> changed;
+	for (int clusterIndex = 0; clusterIndex < int(mClusters.size()); clusterIndex++)
+	{
+		const SCluster& cluster = mClusters[clusterIndex];
+		bool clusterChanged = false;
+		for (int y = cluster.mBottom; y < cluster.mBottom + cluster.mHeight; y++)
+		{
+			for (int x = cluster.mLeft; x < cluster.mLeft + cluster.mWidth; x++)
+			{
+				int index = terrain.Index(x, y);
+				if (mTerrain[index] != terrain[index])
+				{
+					mTerrain[index] = terrain[index];
+					clusterChanged = true;
+				}
+			}
+		}
+		if (clusterChanged)
+		{
+			changed.push_back(clusterIndex);
+		}
+	}
+	RebuildClusters(terrain, changed);
+	mMapVersion = terrain.GetVersion();
+}
+
+//Tells the search which squares have changed since the last call, so only their clusters are rebuilt.
+void CSearchHPAStar::UpdateCells(const TerrainMap& terrain, const vector<SIntVector>& changed)
+{
+	if (mClusters.empty() || terrain.GetId() != mMapId || terrain.GetWidth() != mMapWidth || terrain.GetHeight() != mMapHeight)
+	{
+		return;
+	}
+
+	vector<int> changedClusters;
+	for (auto it = changed.begin(); it != changed.end(); it++)
+	{
+		if (terrain.InBounds(it->x, it->y))
+		{
+			int index = terrain.Index(it->x, it->y);
+			if (mTerrain[index] != terrain[index])
+			{
+				mTerrain[index] = terrain[index];
+				changedClusters.push_back(ClusterOf(terrain, index));
+			}
+		}
+	}
+	sort(changedClusters.begin(), changedClusters.end());
+	changedClusters.erase(unique(changedClusters.begin(), changedClusters.end()), changedClusters.end());
+	RebuildClusters(terrain, changedClusters);
+
+	//Each change to a square moves the version on by one. If fewer squares were given than that, some changes were missed,
+	//so the version is left for FindPath to find the rest.
+	if (changed.size() >= terrain.GetVersion() - mMapVersion)
+	{
+		mMapVersion = terrain.GetVersion();
+	}
+}
+
+// This function takes ownership of the start and goal pointers that are passed in from the calling code.
+// Ownership is not returned at the end, so the start and goal nodes are consumed.
+// The Path is returned through the reference parameter.
+bool CSearchHPAStar::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+{
+	NodeList openList;
+	NodeList closedList;
+	openList.push_back(move(start));
+
+	//Until every segment has been refined, or there is no path.
+	EStepPathResults result;
+	do
+	{
+		result = StepPath(terrain, openList, closedList, goal, path);
+		if (result == EStepPathResults::PATH_FOUND)
+		{
+			return true;
+		}
+	} while (result != EStepPathResults::NO_PATH);
+
+	return false;
+}
+
+EStepPathResults CSearchHPAStar::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+{
+	//The closed list is only empty on the first step of a search, when the open list holds the start node.
+	//Find the abstract path, and put the waypoints still to be reached on the open list.
+	if (closedList.empty())
+	{
+		StartStats();
+		mStats.mEpsilon = 0.0; //Paths between transitions stay inside clusters, so there is no bound on the cost.
+		if (openList.empty())
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+
+		int startIndex = terrain.Index(openList.front()->x, openList.front()->y);
+		int goalIndex = terrain.Index(goal->x, goal->y);
+		if (terrain[goalIndex] == ENodeType::wall || !mMovement.CanReach(terrain, startIndex, goalIndex))
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+
+		PrepareGraph(terrain);
+		if (!FindAbstractPath(terrain, startIndex, goalIndex))
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+
+		path.push_back(unique_ptr<SNode>(new SNode{ openList.front()->x, openList.front()->y, 0 }));
+		closedList.push_back(move(openList.front()));
+		openList.clear();
+		for (int waypoint = 1; waypoint < int(mWaypoints.size()); waypoint++)
+		{
+			openList.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(mWaypoints[waypoint]), terrain.IndexToY(mWaypoints[waypoint]), 0 }));
+		}
+		mNextWaypoint = 1;
+	}
+	else if (mNextWaypoint < int(mWaypoints.size()))
+	{
+		RefineSegment(terrain, path);
+		closedList.push_back(move(openList.front()));
+		openList.pop_front();
+		mNextWaypoint++;
+	}
+
+	if (mNextWaypoint >= int(mWaypoints.size()))
+	{
+		FinishStats();
+		return EStepPathResults::PATH_FOUND;
+	}
+	return EStepPathResults::STEP_SUCCESS;
+}
+
+//The memory held by the abstract graph and the arrays indexed by square.
+long long CSearchHPAStar::ScratchBytes() const
+{
+	long long bytes = (mEntranceSlot.capacity() + mLocalCosts.capacity() + mLocalParents.capacity() + mAbstractCosts.capacity() +
+		mAbstractParents.capacity()) * sizeof(int) + mAbstractStamps.capacity() * sizeof(unsigned int) + mTerrain.capacity() +
+		mClusters.capacity() * sizeof(SCluster);
+	for (auto cluster = mClusters.begin(); cluster != mClusters.end(); cluster++)
+	{
+		bytes += (cluster->mEastTransitions.capacity() + cluster->mNorthTransitions.capacity()) * sizeof(pair<int, int>) +
+			(cluster->mEntrances.capacity() + cluster->mCosts.capacity()) * sizeof(int) + cluster->mPartners.capacity() * sizeof(vector<int>);
+		for (auto partners = cluster->mPartners.begin(); partners != cluster->mPartners.end(); partners++)
+		{
+			bytes += partners->capacity() * sizeof(int);
+		}
+	}
+	return bytes;
+}
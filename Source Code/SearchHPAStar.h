@@ -0,0 +1,139 @@
+//Leo Croft
+
+// SearchHPAStar.h
+// ===============
+//
+// Declaration of Search class for hierarchical path-finding (HPA*)
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include "Movement.h"     // Four or eight way movement
+
+const int HPA_DEFAULT_CLUSTER_SIZE = 16;
+const int HPA_MAX_SINGLE_TRANSITION_WIDTH = 6; //Entrances narrower than this get one transition in the middle. Wider ones get one at each end.
+
+// The map is split into square clusters. Wherever two neighbouring clusters share an open stretch of border (an entrance), one or two
+// pairs of squares facing each other across it become transitions. The transition squares are the nodes of an abstract graph:
+// Each is joined to the square facing it in the other cluster, and to every other node in its own cluster by the cost of the cheapest
+// route between them that stays inside the cluster. Those costs are worked out once, when the graph is built.
+//
+// A query joins the start and goal to the nodes of their clusters, and searches the abstract graph, which is far smaller than the map.
+// The abstract path is turned back into squares one segment at a time: Each StepPath refines the next segment with a search inside
+// one cluster, so a caller that only needs the first part of the route can stop early. FindPath refines every segment.
+// Paths stay inside clusters between transitions, so they can be slightly more expensive than the cheapest path.
+//
+// The graph is kept between calls. When the map changes only the clusters containing changed squares, and the clusters next to them
+// (which share their borders), are rebuilt. Tell the search which squares changed with UpdateCells; Otherwise FindPath compares the map
+// against its copy to find them. A different map, or a different size of map, builds the graph from scratch.
+//
+// With eight way movement the searches inside clusters move diagonally, but the graph only crosses borders between squares facing each other.
+// Without cutting corners that loses nothing but cost, as a diagonal step across a border passes two open squares that face each other.
+// With corners cut, two clusters that only touch diagonally between walls are not joined, and a path that has to squeeze through there isn't found,
+// so NewSearch uses eight way A* instead of HPA* when corners are cut.
+class CSearchHPAStar : public ISearch
+{
+private:
+	//One cluster of the map. Transitions are stored by the cluster to the west or south of the border.
+	struct SCluster
+	{
+		int mLeft; //The bottom left square of the cluster, and its size. Clusters at the top and right edges of the map may be smaller.
+		int mBottom;
+		int mWidth;
+		int mHeight;
+		vector<pair<int, int>> mEastTransitions; //Pairs of squares facing each other across the east border: (this cluster, the cluster to the east).
+		vector<pair<int, int>> mNorthTransitions; //The same for the north border.
+		vector<int> mEntrances; //The squares of this cluster that are nodes of the abstract graph.
+		vector<vector<int>> mPartners; //For each entrance, the squares facing it in other clusters.
+		vector<int> mCosts; //The cheapest route inside the cluster between each pair of entrances: [from * mEntrances.size() + to]. UNREACHABLE if there isn't one.
+	};
+
+	//An entry in the priority queues. Entries are not removed when a better route is found; The out of date ones are skipped.
+	struct SQueueEntry
+	{
+		int mScore;
+		int mCost;
+		int mIndex;
+
+		bool operator>(const SQueueEntry& other) const
+		{
+			return mScore > other.mScore;
+		}
+	};
+
+	int mClusterSize;
+	SMovementRules mMovement;
+	vector<SCluster> mClusters;
+	int mClustersX = 0; //The number of clusters across and up the map.
+	int mClustersY = 0;
+	vector<int> mEntranceSlot; //For each square, its position in its cluster's mEntrances, or -1 if it isn't an entrance.
+	vector<uint8_t> mTerrain; //Copy of the terrain the graph was built for, used to find changes that weren't passed to UpdateCells.
+	unsigned int mMapId = 0;
+	unsigned int mMapVersion = 0;
+	int mMapWidth = 0;
+	int mMapHeight = 0;
+
+	//Scratch space for searches inside one cluster, indexed by position in the cluster.
+	vector<int> mLocalCosts;
+	vector<int> mLocalParents;
+
+	//Scratch space for the abstract search, indexed the same way as the TerrainMap. A square's cost is only valid if its stamp is mStamp.
+	vector<int> mAbstractCosts;
+	vector<int> mAbstractParents;
+	vector<unsigned int> mAbstractStamps;
+	unsigned int mStamp = 0;
+
+	//The abstract path of the search in progress, and the next segment of it to refine.
+	vector<int> mWaypoints;
+	int mNextWaypoint = 0;
+
+	//The memory held by the abstract graph and the arrays indexed by square.
+	long long ScratchBytes() const;
+
+	int ClusterOf(const TerrainMap& terrain, int index) const;
+
+	//Builds the graph from scratch for a new map.
+	void BuildGraph(const TerrainMap& terrain);
+
+	//Rebuilds the given clusters (whose terrain has changed), and the entrances of the clusters next to them.
+	void RebuildClusters(const TerrainMap& terrain, const vector<int>& changed);
+
+	//Finds the transitions along the east or north border of a cluster.
+	void FindTransitions(const TerrainMap& terrain, int cluster, ECompass border);
+
+	//Collects the entrances of a cluster from the transitions on its four borders, and works out the costs between them.
+	void BuildEntrances(const TerrainMap& terrain, int cluster);
+
+	//Dijkstra's algorithm from the source, without leaving the cluster. Stops once the target is reached, or runs until every square has been reached
+	//if the target is -1. Fills mLocalCosts and mLocalParents. Adds the work done to the statistics, if they are given.
+	void SearchCluster(const TerrainMap& terrain, const SCluster& cluster, int source, int target, SSearchStats* stats = nullptr);
+
+	//The cost that SearchCluster found for the square, or UNREACHABLE.
+	int LocalCost(const TerrainMap& terrain, const SCluster& cluster, int index) const;
+
+	//Searches the abstract graph, and stores the abstract path in mWaypoints. Returns false if there is no path.
+	bool FindAbstractPath(const TerrainMap& terrain, int startIndex, int goalIndex);
+
+	//Adds the squares of the next segment of the abstract path to the path.
+	void RefineSegment(const TerrainMap& terrain, NodeList& path);
+
+	//Brings the graph up to date with the terrain.
+	void PrepareGraph(const TerrainMap& terrain);
+
+public:
+	CSearchHPAStar(int clusterSize = HPA_DEFAULT_CLUSTER_SIZE, const SMovementRules& movement = SMovementRules());
+
+	//Tells the search which squares have changed since the last call, so only their clusters are rebuilt.
+	//Changes to a map other than the one last searched are ignored; Its graph will be built from scratch.
+	//If fewer squares are given than the map has had changes since the last call, FindPath still compares the map to find the rest.
+	void UpdateCells(const TerrainMap& terrain, const vector<SIntVector>& changed);
+
+	// Constructs the path from start to goal for the given terrain
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+
+	// The first step finds the abstract path, and puts its waypoints on the open list. Each following step refines the route to the next
+	// waypoint, moving it to the closed list and adding its squares to the path.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
+};
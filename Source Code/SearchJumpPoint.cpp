@@ -0,0 +1,261 @@
+//Leo Croft
+
+// SearchJumpPoint.cpp
+// ===================
+//
+// Implementation of Search class for Jump Point Search on a 4-connected grid (JPS4)
+//
+
+#include "SearchJumpPoint.h" // Declaration of this class
+#include <climits>
+#include <cstdlib>
+
+//True if a path could have to stop at the square whatever direction it arrives from: the goal, and squares next to wood or water.
+bool CSearchJumpPoint::IsStop(const TerrainMap& terrain, int index) const
+{
+	if (index == mGoalIndex)
+	{
+		return true;
+	}
+	for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+	{
+		ENodeType neighbour = terrain[index + terrain.Offset(ECompass(direction))];
+		if (neighbour != ENodeType::wall && neighbour != ENodeType::clear)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//Moves from the square in a straight line until a jump point is found. Returns the jump point, or -1 if a wall is reached first.
+int CSearchJumpPoint::Jump(const TerrainMap& terrain, int from, ECompass direction) const
+{
+	int step = terrain.Offset(direction);
+	bool horizontal = (direction == ECompass::East || direction == ECompass::West);
+	int sideStep = (horizontal) ? 0 : terrain.Offset(ECompass::East);
+
+	//The map is surrounded by walls, so the line always ends before leaving the map.
+	for (int current = from + step; ; current += step)
+	{
+		if (terrain[current] == ENodeType::wall)
+		{
+			return -1;
+		}
+		//Wood and water are never jumped across. The search steps onto them one square at a time.
+		if (!IsClear(terrain, current) || IsStop(terrain, current))
+		{
+			return current;
+		}
+
+		if (horizontal)
+		{
+			//The path could turn here to reach a jump point above or below.
+			if (Jump(terrain, current, ECompass::North) != -1 || Jump(terrain, current, ECompass::South) != -1)
+			{
+				return current;
+			}
+		}
+		else
+		{
+			//An obstacle beside the previous square, but not beside this one, means a path could have to turn here.
+			int previous = current - step;
+			if ((!IsClear(terrain, previous + sideStep) && IsClear(terrain, current + sideStep)) ||
+				(!IsClear(terrain, previous - sideStep) && IsClear(terrain, current - sideStep)))
+			{
+				return current;
+			}
+		}
+	}
+}
+
+//Resets the search for a new query. Returns false if the goal can't be reached.
+bool CSearchJumpPoint::Start(const TerrainMap& terrain, int startIndex, int goalIndex)
+{
+	mStartIndex = startIndex;
+	mGoalIndex = goalIndex;
+	mOpen = {};
+	StartStats();
+	if (terrain[goalIndex] == ENodeType::wall || !terrain.CanReach(startIndex, goalIndex))
+	{
+		FinishStats();
+		return false;
+	}
+
+	//Stamps older than mStamp are from previous searches. Start again from 0 before the stamps overflow.
+	if (int(mStamps.size()) != terrain.Size() || mStamp == UINT_MAX)
+	{
+		mCosts.assign(terrain.Size(), 0);
+		mParents.assign(terrain.Size(), -1);
+		mDirections.assign(terrain.Size(), JPS_NO_DIRECTION);
+		mStamps.assign(terrain.Size(), 0);
+		mClosed.assign(terrain.Size(), 0);
+		mStamp = 0;
+	}
+	mStamp++;
+
+	Relax(terrain, startIndex, -1, JPS_NO_DIRECTION, 0);
+	return true;
+}
+
+//Adds a jump point to the open list, if the new route to it is cheaper.
+void CSearchJumpPoint::Relax(const TerrainMap& terrain, int index, int parent, int direction, int cost)
+{
+	if (mStamps[index] == mStamp)
+	{
+		//A square reached horizontally is expanded in more directions than one reached vertically, so a horizontal route of the same cost
+		//replaces a vertical one.
+		bool wasVertical = (mDirections[index] == ECompass::North || mDirections[index] == ECompass::South);
+		bool isHorizontal = (direction == ECompass::East || direction == ECompass::West);
+		if (cost > mCosts[index] || (cost == mCosts[index] && !(wasVertical && isHorizontal)))
+		{
+			return;
+		}
+	}
+
+	if (mStamps[index] == mStamp && mClosed[index] == mStamp)
+	{
+		mStats.mReopenings++;
+	}
+	mStamps[index] = mStamp;
+	mClosed[index] = 0;
+	mCosts[index] = cost;
+	mParents[index] = parent;
+	mDirections[index] = direction;
+	int estimate = abs(terrain.IndexToX(index) - terrain.IndexToX(mGoalIndex)) + abs(terrain.IndexToY(index) - terrain.IndexToY(mGoalIndex));
+	mOpen.push({ cost + estimate, cost, index });
+	mStats.mNodesGenerated++;
+}
+
+//Expands the next jump point on the open list. Returns the square expanded, or -1 if the search has finished.
+int CSearchJumpPoint::Expand(const TerrainMap& terrain, EStepPathResults& result)
+{
+	//Skip the entries for squares that have since been reached by a better route.
+	while (!mOpen.empty() && (mClosed[mOpen.top().mIndex] == mStamp || mCosts[mOpen.top().mIndex] != mOpen.top().mCost))
+	{
+		mOpen.pop();
+	}
+	if (mOpen.empty())
+	{
+		result = EStepPathResults::NO_PATH;
+		FinishStats();
+		return -1;
+	}
+
+	SQueueEntry current = mOpen.top();
+	mOpen.pop();
+	if (current.mIndex == mGoalIndex)
+	{
+		result = EStepPathResults::PATH_FOUND;
+		FinishStats();
+		return -1;
+	}
+	mClosed[current.mIndex] = mStamp;
+	mStats.mNodesExpanded++;
+
+	//Work out which directions a path through this square could leave in.
+	//The start, wood and water, and squares next to them are expanded in every direction.
+	//Otherwise a path never turns back, can turn vertical after moving horizontally, and only turns horizontal after moving vertically when forced.
+	int arrival = mDirections[current.mIndex];
+	bool directions[ECompass::West + 1] = { true, true, true, true };
+	if (arrival != JPS_NO_DIRECTION && IsClear(terrain, current.mIndex) && !IsStop(terrain, current.mIndex))
+	{
+		int back = (arrival + 2) % 4;
+		directions[back] = false;
+		if (arrival == ECompass::North || arrival == ECompass::South)
+		{
+			int previous = current.mIndex + terrain.Offset(ECompass(back));
+			for (int side = ECompass::East; side <= ECompass::West; side += 2)
+			{
+				int sideStep = terrain.Offset(ECompass(side));
+				directions[side] = !IsClear(terrain, previous + sideStep) && IsClear(terrain, current.mIndex + sideStep);
+			}
+		}
+	}
+
+	for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+	{
+		if (!directions[direction])
+		{
+			continue;
+		}
+		int jumpPoint = Jump(terrain, current.mIndex, ECompass(direction));
+		if (jumpPoint == -1)
+		{
+			continue;
+		}
+
+		//Every square before the jump point is clear, and costs 1 to move onto.
+		int distance = abs(terrain.IndexToX(jumpPoint) - terrain.IndexToX(current.mIndex)) + abs(terrain.IndexToY(jumpPoint) - terrain.IndexToY(current.mIndex));
+		Relax(terrain, jumpPoint, current.mIndex, direction, current.mCost + distance - 1 + int(terrain[jumpPoint]));
+	}
+	UpdatePeaks(mOpen.size(), mStats.mNodesExpanded);
+
+	result = EStepPathResults::STEP_SUCCESS;
+	return current.mIndex;
+}
+
+//Follows the jump points back from the goal, filling in the squares between them.
+void CSearchJumpPoint::BuildPath(const TerrainMap& terrain, NodeList& path) const
+{
+	int index = mGoalIndex;
+	path.push_front(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+	while (mParents[index] != -1)
+	{
+		//Jump points are joined by straight lines, so step back along the line to the parent.
+		int parent = mParents[index];
+		int step = terrain.Offset(ECompass((mDirections[index] + 2) % 4));
+		for (index += step; index != parent; index += step)
+		{
+			path.push_front(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+		}
+		path.push_front(unique_ptr<SNode>(new SNode{ terrain.IndexToX(index), terrain.IndexToY(index), 0 }));
+	}
+}
+
+// The search keeps its own open list, so FindPath doesn't create any nodes until the path is built.
+bool CSearchJumpPoint::FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+{
+	if (!Start(terrain, terrain.Index(start->x, start->y), terrain.Index(goal->x, goal->y)))
+	{
+		return false;
+	}
+
+	EStepPathResults result;
+	while (Expand(terrain, result) != -1)
+	{
+	}
+
+	if (result == EStepPathResults::PATH_FOUND)
+	{
+		BuildPath(terrain, path);
+		return true;
+	}
+	return false;
+}
+
+EStepPathResults CSearchJumpPoint::StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+{
+	//The closed list is only empty on the first step of a search, when the open list holds the start node.
+	if (closedList.empty())
+	{
+		if (openList.empty() || !Start(terrain, terrain.Index(openList.front()->x, openList.front()->y), terrain.Index(goal->x, goal->y)))
+		{
+			return EStepPathResults::NO_PATH;
+		}
+		closedList.push_back(move(openList.front()));
+		openList.clear();
+	}
+
+	EStepPathResults result;
+	int expanded = Expand(terrain, result);
+	if (expanded != -1)
+	{
+		closedList.push_back(unique_ptr<SNode>(new SNode{ terrain.IndexToX(expanded), terrain.IndexToY(expanded), 0 }));
+	}
+	else if (result == EStepPathResults::PATH_FOUND)
+	{
+		BuildPath(terrain, path);
+	}
+	return result;
+}
@@ -0,0 +1,94 @@
+//Leo Croft
+
+// SearchJumpPoint.h
+// =================
+//
+// Declaration of Search class for Jump Point Search on a 4-connected grid (JPS4)
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include <queue>
+#include <functional>
+
+const int JPS_NO_DIRECTION = -1; //The arrival direction of the start, which is expanded in every direction.
+
+// A* that skips across open ground. On clear terrain many paths of the same cost lead to each square, and A* expands the squares of all of
+// them. Only one of them needs to be searched: the one that moves horizontally as early as it can, and only turns back to horizontal after
+// moving vertically when an obstacle forces it to.
+// Instead of adding every neighbour to the open list, the search moves in a straight line until it reaches a square where such a path could
+// have to turn (a jump point), and only that square is added. Moving horizontally, a square is a jump point if a vertical jump from it finds
+// one. Moving vertically, a square is a jump point if the square beside it is open and the square beside the previous one isn't.
+//
+// Only clear squares are jumped across. Wood and water squares, and the clear squares next to them, are always jump points, and are
+// expanded in all four directions as A* would. So paths are still the cheapest, and mixed terrain is searched much as A* searches it.
+// The path returned includes every square, not just the jump points.
+class CSearchJumpPoint : public ISearch
+{
+private:
+	//An entry in the open list. Entries are not removed when a better route is found; The out of date ones are skipped.
+	struct SQueueEntry
+	{
+		int mScore;
+		int mCost;
+		int mIndex;
+
+		//Ties are broken towards the node furthest from the start, as they are closer to the goal.
+		bool operator>(const SQueueEntry& other) const
+		{
+			return mScore > other.mScore || (mScore == other.mScore && mCost < other.mCost);
+		}
+	};
+
+	//Search state, indexed the same way as the TerrainMap. A square's cost, parent and direction are only valid if its stamp is mStamp.
+	//A square is closed if its closed stamp is mStamp.
+	vector<int> mCosts;
+	vector<int> mParents; //The jump point the square was reached from.
+	vector<int> mDirections; //The ECompass direction the square was reached moving in.
+	vector<unsigned int> mStamps;
+	vector<unsigned int> mClosed;
+	unsigned int mStamp = 0;
+	priority_queue<SQueueEntry, vector<SQueueEntry>, greater<SQueueEntry>> mOpen;
+
+	int mStartIndex = 0;
+	int mGoalIndex = 0;
+
+	long long ScratchBytes() const
+	{
+		return (mCosts.capacity() + mParents.capacity() + mDirections.capacity()) * sizeof(int) +
+			(mStamps.capacity() + mClosed.capacity()) * sizeof(unsigned int);
+	}
+
+	//True if the square is clear terrain. Walls, wood and water are not.
+	bool IsClear(const TerrainMap& terrain, int index) const
+	{
+		return terrain[index] == ENodeType::clear;
+	}
+
+	//True if a path could have to stop at the square whatever direction it arrives from: the goal, and squares next to wood or water.
+	bool IsStop(const TerrainMap& terrain, int index) const;
+
+	//Moves from the square in a straight line until a jump point is found. Returns the jump point, or -1 if a wall is reached first.
+	int Jump(const TerrainMap& terrain, int from, ECompass direction) const;
+
+	//Resets the search for a new query. Returns false if the goal can't be reached.
+	bool Start(const TerrainMap& terrain, int startIndex, int goalIndex);
+
+	//Adds a jump point to the open list, if the new route to it is cheaper.
+	void Relax(const TerrainMap& terrain, int index, int parent, int direction, int cost);
+
+	//Expands the next jump point on the open list. Returns the square expanded, or -1 if the search has finished.
+	int Expand(const TerrainMap& terrain, EStepPathResults& result);
+
+	//Follows the jump points back from the goal, filling in the squares between them.
+	void BuildPath(const TerrainMap& terrain, NodeList& path) const;
+
+public:
+	// Constructs the path from start to goal for the given terrain
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path);
+
+	// Each step expands one jump point, and adds it to the closed list.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path);
+};
@@ -0,0 +1,163 @@
+//Leo Croft
+
+// SearchKernel.h
+// ==============
+//
+// Best first search, built at compile time from a neighbourhood, a heuristic and an open list. See SearchPolicies.h
+//
+
+#pragma once
+
+#include "Definitions.h"  // Type definitions
+#include "Search.h"       // Base (=interface) class definition
+#include "SearchState.h"  // Per-cell search state
+#include "SearchPolicies.h" // The parts the kernel is built from
+
+// A* over the map, with each part chosen by a template parameter:
+//   TNeighbourhood - The squares each square can move to, and what each move costs. See SFourConnected and SEightConnected.
+//   THeuristic     - The estimate of the cost to the goal. A zero heuristic makes the search Dijkstra's algorithm. See CManhattanHeuristic.
+//                    It must never overestimate under the neighbourhood's costs, so eight way movement needs COctileHeuristic or a zero heuristic.
+//   TOpenList      - How the open list is ordered. See CHeapOpenList and CBucketOpenList.
+// The policies are plain classes rather than virtual ones, so every call into them is inlined, and the loop over the neighbours is unrolled.
+// The search types in SearchFactory.h are instantiations of this class; See SearchAStar.h.
+//
+// The open and closed lists are real node lists, so StepPath can show the search as it runs. The state of each cell (which list it is on,
+// and its cost) is kept in a CSearchState, so the lists never need to be scanned.
+template <class TNeighbourhood, class THeuristic, class TOpenList>
+class CSearchKernel : public ISearch
+{
+private:
+	TNeighbourhood mNeighbourhood;
+	THeuristic mHeuristic;
+	TOpenList mOpenListPolicy;
+	CSearchState mSearchState; //Tracks which list each cell is on. Reused between searches.
+
+	long long ScratchBytes() const
+	{
+		return mSearchState.Bytes() + mOpenListPolicy.Bytes();
+	}
+
+public:
+	CSearchKernel(const THeuristic& heuristic = THeuristic(), const TNeighbourhood& neighbourhood = TNeighbourhood()) :
+		mNeighbourhood(neighbourhood), mHeuristic(heuristic), mOpenListPolicy(TNeighbourhood::SCORE_RANGE)
+	{
+	}
+
+	// Constructs the path from start to goal for the given terrain
+	// This function takes ownership of the start and goal pointers that are passed in from the calling code.
+	// Ownership is not returned at the end, so the start and goal nodes are consumed.
+	// The Path is returned through the reference parameter.
+	bool FindPath(const TerrainMap& terrain, unique_ptr<SNode> start, unique_ptr<SNode> goal, NodeList& path)
+	{
+		NodeList openList;
+		NodeList closedList;
+
+		//Create the first node in the path- the origin of the search.
+		//Both the parent and the cost are 0. The first step works out its score.
+		openList.push_back(move(start));
+
+		//Until goal is found or OpenList is empty.
+		EStepPathResults result;
+		do
+		{
+			result = StepPath(terrain, openList, closedList, goal, path);
+			if (result == EStepPathResults::PATH_FOUND)
+			{
+				return true;
+			}
+		} while (result != EStepPathResults::NO_PATH);
+
+		return false;
+	}
+
+	// Performs a single step of the FindPath function.
+	// Performs the function of the loop in FindPath. Start should be the first node in openlist the first time StepPath is called.
+	// Takes the openlist and closedlist as additionally reference parameters; These are used to set textures and create models.
+	// Goal is passed as a reference parameter because it is used for comparison; It is not added onto the openlist until it is found by the search.
+	EStepPathResults StepPath(const TerrainMap& terrain, NodeList& openList, NodeList& closedList, unique_ptr<SNode>& goal, NodeList& path)
+	{
+		//The closed list is only empty on the first step of a search, when the open list holds the start node.
+		//Reset the cell states and record the nodes the caller placed on the open list.
+		//Those nodes are where the search starts from, so their cost is 0 and their score is just the estimate; The caller doesn't need to set it.
+		if (closedList.empty())
+		{
+			StartStats();
+			if (!CanReachGoal(terrain, openList, goal.get(), mNeighbourhood.Rules()))
+			{
+				FinishStats();
+				return EStepPathResults::NO_PATH;
+			}
+			mHeuristic.Prepare(terrain, goal.get());
+			mSearchState.Reset(terrain);
+			mOpenListPolicy.Clear();
+			for (int i = 0; i < int(openList.size()); i++)
+			{
+				openList[i]->mScore = mHeuristic.Estimate(openList[i]->x, openList[i]->y);
+				mSearchState.Open(openList[i].get(), 0);
+			}
+			mOpenListPolicy.Seed(openList, mSearchState);
+			mStats.mNodesGenerated = openList.size();
+		}
+
+		//Pop the node with the lowest score from the open list and make it the current node.
+		unique_ptr<SNode> current = mOpenListPolicy.Pop(openList, mSearchState);
+		if (!current)
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+
+		//The end is found.
+		//Follow the reverse path from the end node to build the path for the ball.
+		//Then exit the search using return.
+		if (current->NodesMatch(goal.get()))
+		{
+			BuildPath(path, closedList, move(current));
+			FinishStats();
+			return EStepPathResults::PATH_FOUND;
+		}
+
+		int index = terrain.Index(current->x, current->y); //The position of the current node in the terrain and the search state.
+		int currentCost = mSearchState.Cell(index).mCost; //The cost of the route from the start to the current node.
+
+		//The map is surrounded by walls, so the neighbours never need to be checked against the bounds of the map.
+		for (int direction = 0; direction < TNeighbourhood::NUM_DIRECTIONS; direction++)
+		{
+			int x = current->x + MOVE_DX[direction];
+			int y = current->y + MOVE_DY[direction];
+			int neighbour = index + SMovementRules::Offset(terrain, direction);
+			if (!mNeighbourhood.CanMove(terrain, index, neighbour, direction))
+			{
+				continue;
+			}
+
+			//If the next node has not been seen, or the new route to it is better than the one found before, add it to the openlist.
+			int newCost = currentCost + mNeighbourhood.MoveCost(terrain, index, neighbour, direction);
+			SCellState& cell = mSearchState.Cell(neighbour);
+			if (cell.mStatus == ENodeStatus::Unvisited || newCost < cell.mCost)
+			{
+				mStats.mNodesGenerated++;
+				if (cell.mStatus == ENodeStatus::OnClosedList)
+				{
+					mStats.mReopenings++;
+				}
+				mOpenListPolicy.Add(openList, mSearchState, cell, current.get(), x, y, newCost, newCost + mHeuristic.Estimate(x, y));
+			}
+		}
+
+		mSearchState.Close(current.get());
+		closedList.push_back(move(current));
+		mStats.mNodesExpanded++;
+		UpdatePeaks(openList.size(), closedList.size());
+
+		if (openList.empty())
+		{
+			FinishStats();
+			return EStepPathResults::NO_PATH;
+		}
+		else
+		{
+			return EStepPathResults::STEP_SUCCESS;
+		}
+	}
+};
@@ -0,0 +1,365 @@
+//Leo Croft
+
+// SearchPolicies.h
+// ================
+//
+// Policy classes that CSearchKernel is built from: which squares neighbour each other, how the cost to the goal is estimated,
+// and how the open list is ordered
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "SearchState.h" // Per-cell search state
+#include "SearchUtilities.h" // Heap comparison
+#include "BucketQueue.h" // Bucket open list
+#include "Landmarks.h" // ALT heuristic
+#include "Movement.h" // Move directions and costs
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+//Terrain costs are at most 3 and the Manhattan distance changes by at most 1 per move,
+//so a node on the open list never has a score more than this far above the lowest one.
+const int ASTAR_SCORE_RANGE = ENodeType::water + 1;
+
+//The same for eight way movement, where a move costs up to DIAGONAL_MOVE_SCALE times the terrain and changes the octile distance by as much.
+const int ASTAR_EIGHT_WAY_SCORE_RANGE = (ENodeType::water + 1) * DIAGONAL_MOVE_SCALE;
+
+/*********************************************************************************************************************************
+ * Neighbourhoods. Each has the number of directions to try from MOVE_DX and MOVE_DY (see Movement.h), whether each move is allowed,
+ * and what it costs. The kernel's loop over them has a fixed count, so the compiler unrolls it and the direction of each move is known.
+ *********************************************************************************************************************************/
+
+//North, east, south and west, as ECompass. Moving onto a square costs its terrain.
+struct SFourConnected
+{
+	static const int NUM_DIRECTIONS = 4;
+	static const int SCORE_RANGE = ASTAR_SCORE_RANGE;
+
+	//The movement rules the neighbourhood follows, for checks outside the kernel.
+	SMovementRules Rules() const
+	{
+		return SMovementRules();
+	}
+
+	//True if the move from the square at index in the direction, onto the square at neighbour, is allowed.
+	bool CanMove(const TerrainMap& terrain, int index, int neighbour, int direction) const
+	{
+		return terrain[neighbour] != ENodeType::wall;
+	}
+
+	//The cost of moving from the square at index in the direction, onto the square at neighbour. The move is allowed.
+	int MoveCost(const TerrainMap& terrain, int index, int neighbour, int direction) const
+	{
+		return int(terrain[neighbour]);
+	}
+};
+
+//The four compass directions and the diagonals, with diagonal moves costing DIAGONAL_MOVE_SCALE / ORTHOGONAL_MOVE_SCALE times as much.
+//Whether a diagonal may cut the corner of a wall is chosen when the search is created.
+struct SEightConnected
+{
+	static const int NUM_DIRECTIONS = MAX_MOVE_DIRECTIONS;
+	static const int SCORE_RANGE = ASTAR_EIGHT_WAY_SCORE_RANGE;
+
+	SMovementRules mRules;
+
+	SEightConnected(bool cutCorners = false)
+	{
+		mRules.mMovement = EMovement::EightWay;
+		mRules.mCutCorners = cutCorners;
+	}
+
+	SMovementRules Rules() const
+	{
+		return mRules;
+	}
+
+	bool CanMove(const TerrainMap& terrain, int index, int neighbour, int direction) const
+	{
+		return mRules.CanMove(terrain, index, direction);
+	}
+
+	int MoveCost(const TerrainMap& terrain, int index, int neighbour, int direction) const
+	{
+		return int(terrain[neighbour]) * ((direction <= ECompass::West) ? ORTHOGONAL_MOVE_SCALE : DIAGONAL_MOVE_SCALE);
+	}
+};
+
+/*********************************************************************************************************************************
+ * Heuristics. Prepare is called at the start of each search, then Estimate gives the estimate of the cost from a square to the goal.
+ *********************************************************************************************************************************/
+
+//No estimate, which makes the search Dijkstra's algorithm.
+class CZeroHeuristic
+{
+public:
+	void Prepare(const TerrainMap& terrain, const SNode* goal)
+	{
+	}
+
+	int Estimate(int x, int y) const
+	{
+		return 0;
+	}
+};
+
+//The Manhattan distance. Terrain costs at least 1, so it never overestimates.
+class CManhattanHeuristic
+{
+private:
+	int mGoalX = 0;
+	int mGoalY = 0;
+
+public:
+	void Prepare(const TerrainMap& terrain, const SNode* goal)
+	{
+		mGoalX = goal->x;
+		mGoalY = goal->y;
+	}
+
+	//INT_MIN at the goal, so the goal is taken from the open list as soon as it is found. That is only safe because every square next to the
+	//goal has the same estimate. (The same as SNode::CalculateManhattanDistance.)
+	int Estimate(int x, int y) const
+	{
+		int distance = abs(x - mGoalX) + abs(y - mGoalY);
+		return (distance == 0) ? INT_MIN : distance;
+	}
+};
+
+//The larger of the Manhattan distance and the landmark bound, on maps the landmarks were built for. The Manhattan distance alone on others.
+class CLandmarkHeuristic
+{
+private:
+	const CLandmarks* mpLandmarks; //Not owned. Only read, so one set can be shared by searches on several threads.
+	bool mActive = false; //Set by Prepare, if the landmarks match the map being searched.
+	int mGoalX = 0;
+	int mGoalY = 0;
+
+public:
+	CLandmarkHeuristic(const CLandmarks* landmarks = nullptr) : mpLandmarks(landmarks)
+	{
+	}
+
+	void Prepare(const TerrainMap& terrain, const SNode* goal)
+	{
+		mActive = (mpLandmarks != nullptr && mpLandmarks->Matches(terrain));
+		mGoalX = goal->x;
+		mGoalY = goal->y;
+	}
+
+	//The landmark bound differs between the squares next to the goal, so with landmarks the goal waits for its turn like any other square.
+	int Estimate(int x, int y) const
+	{
+		int distance = abs(x - mGoalX) + abs(y - mGoalY);
+		if (!mActive)
+		{
+			return (distance == 0) ? INT_MIN : distance;
+		}
+		return max(distance, mpLandmarks->LowerBound(x, y, mGoalX, mGoalY));
+	}
+};
+
+//The octile distance, for eight way movement: The cost of the route across clear terrain, going diagonally until level with the goal.
+//It is 0 at the goal. The squares around the goal have different estimates, so the goal can't be hurried off the open list the way
+//CManhattanHeuristic does.
+class COctileHeuristic
+{
+private:
+	int mGoalX = 0;
+	int mGoalY = 0;
+
+public:
+	void Prepare(const TerrainMap& terrain, const SNode* goal)
+	{
+		mGoalX = goal->x;
+		mGoalY = goal->y;
+	}
+
+	int Estimate(int x, int y) const
+	{
+		int dx = abs(x - mGoalX);
+		int dy = abs(y - mGoalY);
+		return ORTHOGONAL_MOVE_SCALE * max(dx, dy) + (DIAGONAL_MOVE_SCALE - ORTHOGONAL_MOVE_SCALE) * min(dx, dy);
+	}
+};
+
+/*********************************************************************************************************************************
+ * Open lists. The nodes are owned by the NodeList the caller passes to StepPath; The policy decides how they are ordered in it.
+ * Seed is called once the nodes placed on the open list by the caller have been recorded in the search state.
+ * Each is constructed with the neighbourhood's SCORE_RANGE, the largest difference between scores on the open list.
+ *********************************************************************************************************************************/
+
+//A binary heap kept in the open list. O(log n) per push and pop. Works with any scores.
+//A better route to a node pushes a new node rather than editing the old one; The old one is skipped when it is popped.
+class CHeapOpenList
+{
+public:
+	CHeapOpenList(int scoreRange = ASTAR_SCORE_RANGE)
+	{
+	}
+
+	void Clear()
+	{
+	}
+
+	void Seed(NodeList& openList, CSearchState& state)
+	{
+		make_heap(openList.begin(), openList.end(), HeapCompareScores);
+	}
+
+	//Pushes a node for the cell onto the open list. If it replaces a node on the closed list, the old node stays there so any children
+	//of it keep a valid parent.
+	void Add(NodeList& openList, CSearchState& state, SCellState& cell, SNode* parent, int x, int y, int cost, int score)
+	{
+		openList.push_back(unique_ptr<SNode>(new SNode{ x, y, score, parent }));
+		state.Open(openList.back().get(), cost);
+		push_heap(openList.begin(), openList.end(), HeapCompareScores);
+	}
+
+	//Removes the node with the lowest score from the open list, or returns an empty pointer if there are none left.
+	unique_ptr<SNode> Pop(NodeList& openList, CSearchState& state)
+	{
+		unique_ptr<SNode> current;
+		do
+		{
+			if (openList.empty())
+			{
+				return current;
+			}
+			pop_heap(openList.begin(), openList.end(), HeapCompareScores);
+			current = move(openList.back());
+			openList.pop_back();
+		} while (state.Cell(current->x, current->y).mpNode != current.get());
+		return current;
+	}
+
+	long long Bytes() const
+	{
+		return 0;
+	}
+};
+
+//The open list the A* search used before the heap: The whole list is sorted by score before every pop, O(n log n) per pop.
+//Only for measuring the other open lists against (Benchmark runs it as AStarSorted); No search type uses it.
+class CSortedOpenList
+{
+public:
+	CSortedOpenList(int scoreRange = ASTAR_SCORE_RANGE)
+	{
+	}
+
+	void Clear()
+	{
+	}
+
+	void Seed(NodeList& openList, CSearchState& state)
+	{
+	}
+
+	//A better route to a node pushes a new node, as in CHeapOpenList.
+	void Add(NodeList& openList, CSearchState& state, SCellState& cell, SNode* parent, int x, int y, int cost, int score)
+	{
+		openList.push_back(unique_ptr<SNode>(new SNode{ x, y, score, parent }));
+		state.Open(openList.back().get(), cost);
+	}
+
+	//Removes the node with the lowest score from the open list, or returns an empty pointer if there are none left.
+	unique_ptr<SNode> Pop(NodeList& openList, CSearchState& state)
+	{
+		unique_ptr<SNode> current;
+		do
+		{
+			if (openList.empty())
+			{
+				return current;
+			}
+			sort(openList.begin(), openList.end(), CompareScores);
+			current = move(openList.front());
+			openList.pop_front();
+		} while (state.Cell(current->x, current->y).mpNode != current.get());
+		return current;
+	}
+
+	long long Bytes() const
+	{
+		return 0;
+	}
+};
+
+//The open list is unordered and a bucket per score is used to find the best node. O(1) per push and pop, relies on the small range of
+//terrain costs. A node already on the open list is edited in place and pushed into the bucket for its new score; The copy left in the old
+//bucket is skipped when it is popped.
+class CBucketOpenList
+{
+private:
+	CBucketQueue mBucketQueue;
+
+public:
+	CBucketOpenList(int scoreRange = ASTAR_SCORE_RANGE) : mBucketQueue(scoreRange)
+	{
+	}
+
+	void Clear()
+	{
+		mBucketQueue.Clear();
+	}
+
+	void Seed(NodeList& openList, CSearchState& state)
+	{
+		for (int i = 0; i < int(openList.size()); i++)
+		{
+			state.Cell(openList[i]->x, openList[i]->y).mOpenIndex = i;
+			mBucketQueue.Push(openList[i].get());
+		}
+	}
+
+	void Add(NodeList& openList, CSearchState& state, SCellState& cell, SNode* parent, int x, int y, int cost, int score)
+	{
+		if (cell.mStatus == ENodeStatus::OnOpenList)
+		{
+			cell.mpNode->mpParent = parent;
+			cell.mpNode->mScore = score;
+			cell.mCost = cost;
+			mBucketQueue.Push(cell.mpNode);
+			return;
+		}
+
+		openList.push_back(unique_ptr<SNode>(new SNode{ x, y, score, parent }));
+		state.Open(openList.back().get(), cost);
+		cell.mOpenIndex = openList.size() - 1;
+		mBucketQueue.Push(openList.back().get());
+	}
+
+	//Removes the node with the lowest score from the open list, or returns an empty pointer if there are none left.
+	unique_ptr<SNode> Pop(NodeList& openList, CSearchState& state)
+	{
+		//Skip nodes that have since been pushed into a better bucket, or have been replaced.
+		SNode* best;
+		do
+		{
+			best = mBucketQueue.Pop();
+			if (best == nullptr)
+			{
+				return unique_ptr<SNode>();
+			}
+		} while (state.Cell(best->x, best->y).mpNode != best || state.Cell(best->x, best->y).mStatus != ENodeStatus::OnOpenList);
+
+		//Take the node out of the open list by swapping the last node into its place, so the order of the open list doesn't matter.
+		int index = state.Cell(best->x, best->y).mOpenIndex;
+		unique_ptr<SNode> current = move(openList[index]);
+		if (index != int(openList.size()) - 1)
+		{
+			openList[index] = move(openList.back());
+			state.Cell(openList[index]->x, openList[index]->y).mOpenIndex = index;
+		}
+		openList.pop_back();
+		return current;
+	}
+
+	long long Bytes() const
+	{
+		return mBucketQueue.Bytes();
+	}
+};
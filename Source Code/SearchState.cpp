@@ -0,0 +1,29 @@
+//Leo Croft
+
+// SearchState.cpp
+// ===============
+//
+// Implementation of the dense per-cell search state
+//
+
+#include "SearchState.h" // Declaration of this class
+
+//Prepares the state for a new search over the given map. Only reallocates when the size of the map changes.
+void CSearchState::Reset(const TerrainMap& terrain)
+{
+	if (terrain.Size() != int(mCells.size()) || terrain.GetStride() != mStride)
+	{
+		mStride = terrain.GetStride();
+		mCells.assign(terrain.Size(), SCellState());
+		mGeneration = 0;
+	}
+
+	mGeneration++;
+
+	//When the counter wraps around, old stamps could match again, so clear them all.
+	if (mGeneration == 0)
+	{
+		mCells.assign(mCells.size(), SCellState());
+		mGeneration = 1;
+	}
+}
@@ -0,0 +1,88 @@
+//Leo Croft
+
+// SearchState.h
+// =============
+//
+// Dense per-cell search state shared by the search classes.
+// Replaces scanning the open and closed lists to find out if a node has already been seen.
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+
+//Which list (if any) the node for a cell is currently on.
+enum ENodeStatus : unsigned char
+{
+	Unvisited = 0, //The cell has not been reached by the current search.
+	OnOpenList = 1,
+	OnClosedList = 2
+};
+
+//The state of a single cell of the map during a search.
+struct SCellState
+{
+	unsigned int mGeneration = 0; //The search that last wrote to this cell. Data left over from older searches is ignored.
+	ENodeStatus mStatus = ENodeStatus::Unvisited;
+	int mCost = 0; //The cost of the best known route from the start to this cell.
+	SNode* mpNode = nullptr; //The node on the open or closed list for this cell. Its mpParent is the parent of the cell.
+	int mOpenIndex = -1; //The position of the node in the open list. Only kept up to date by open lists that remove nodes from the middle.
+};
+
+// Holds one SCellState per map square, indexed the same way as the TerrainMap, so that membership and "better score" checks are constant time.
+// Resetting between searches is also constant time; each cell is stamped with the search it belongs to,
+// and cells stamped by an older search are treated as unvisited.
+class CSearchState
+{
+private:
+	vector<SCellState> mCells; //Same size and layout as the TerrainMap, including its border.
+	int mStride = 0; //Number of cells in each row of the TerrainMap.
+	unsigned int mGeneration = 0; //Incremented at the start of every search.
+
+public:
+	//Prepares the state for a new search over the given map. Only reallocates when the size of the map changes.
+	void Reset(const TerrainMap& terrain);
+
+	//The memory held by the cell states.
+	long long Bytes() const
+	{
+		return mCells.capacity() * sizeof(SCellState);
+	}
+
+	//Returns the state of the cell. If the cell was last touched by an older search it is reset to unvisited first.
+	SCellState& Cell(int index)
+	{
+		SCellState& cell = mCells[index];
+		if (cell.mGeneration != mGeneration)
+		{
+			cell.mGeneration = mGeneration;
+			cell.mStatus = ENodeStatus::Unvisited;
+			cell.mCost = 0;
+			cell.mpNode = nullptr;
+			cell.mOpenIndex = -1;
+		}
+		return cell;
+	}
+	SCellState& Cell(int x, int y)
+	{
+		return Cell((y + 1) * mStride + (x + 1));
+	}
+
+	//Records that the node is on the open list with the given cost from the start.
+	void Open(SNode* node, int cost)
+	{
+		SCellState& cell = Cell(node->x, node->y);
+		cell.mStatus = ENodeStatus::OnOpenList;
+		cell.mCost = cost;
+		cell.mpNode = node;
+	}
+
+	//Records that the node has been moved onto the closed list.
+	void Close(SNode* node)
+	{
+		SCellState& cell = Cell(node->x, node->y);
+		cell.mStatus = ENodeStatus::OnClosedList;
+		cell.mpNode = node;
+	}
+};
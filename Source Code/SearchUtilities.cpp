@@ -1,6 +1,7 @@
 //Leo Croft
 
 #include "SearchUtilities.h"
+#include <climits>
 
 bool SNode::NodesMatch(const SNode* comparison)
 {
@@ -86,4 +87,65 @@ void BuildPath(NodeList &path, NodeList &closedList, unique_ptr<SNode> current)
 bool CompareScores(unique_ptr<SNode> &i, unique_ptr<SNode> &j)
 {
 	return(i->mScore < j->mScore);
-}
\ No newline at end of file
+}
+
+bool HeapCompareScores(const unique_ptr<SNode> &i, const unique_ptr<SNode> &j)
+{
+	return(i->mScore > j->mScore);
+}
+
+//The cost of following the path: The terrain cost of every node on it except the first, scaled for diagonal moves if the movement allows them.
+int CalculatePathCost(const TerrainMap& terrain, NodeList& path, const SMovementRules& movement)
+{
+	int cost = 0;
+	for (int i = 1; i < int(path.size()); i++)
+	{
+		int direction = movement.Direction(path[i]->x - path[i - 1]->x, path[i]->y - path[i - 1]->y);
+		if (direction < 0)
+		{
+			return INVALID_PATH_COST;
+		}
+		cost += movement.MoveCost(terrain, terrain.Index(path[i]->x, path[i]->y), direction);
+	}
+	return cost;
+}
+
+//Tests that the path runs from start to goal through squares that aren't walls, making only the moves the movement allows.
+bool IsPathValid(const TerrainMap& terrain, NodeList& path, SIntVector start, SIntVector goal, const SMovementRules& movement)
+{
+	if (path.empty() || path.front()->x != start.x || path.front()->y != start.y || path.back()->x != goal.x || path.back()->y != goal.y)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < int(path.size()); i++)
+	{
+		if (!terrain.InBounds(path[i]->x, path[i]->y) || terrain.Get(path[i]->x, path[i]->y) == ENodeType::wall)
+		{
+			return false;
+		}
+		if (i > 0)
+		{
+			int direction = movement.Direction(path[i]->x - path[i - 1]->x, path[i]->y - path[i - 1]->y);
+			if (direction < 0 || !movement.CanMove(terrain, terrain.Index(path[i - 1]->x, path[i - 1]->y), direction))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//Returns false if the map's component index shows that none of the nodes on the open list can reach the goal.
+bool CanReachGoal(const TerrainMap& terrain, NodeList& openList, const SNode* goal, const SMovementRules& movement)
+{
+	int goalIndex = terrain.Index(goal->x, goal->y);
+	for (auto it = openList.begin(); it != openList.end(); it++)
+	{
+		if (movement.CanReach(terrain, terrain.Index((*it)->x, (*it)->y), goalIndex))
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Definitions.h"  // Type definitions
+#include "TerrainMap.h" // Flat grid of terrain
+#include "Movement.h" // Four or eight way movement
 
 //Follows the path backwards from the goal (current) to build the path from nodes on the closedlist.
 void BuildPath(NodeList &path, NodeList &closedList, unique_ptr<SNode> current);
@@ -14,4 +16,21 @@ bool IsNodeOnList(deque<unique_ptr<SNode>> &list, int nodeX, int nodeY);
 //The int is either the index of the node if it exists and is worse, -1 if the node isn't found, or -2 if the node found was better.
 int CheckListForBetter(deque<unique_ptr<SNode>> &list, int nodeX, int nodeY, int nodeScore);
 
-bool CompareScores(unique_ptr<SNode> &i, unique_ptr<SNode> &j); //Returns true is the score of I is smaller than the score of J.
\ No newline at end of file
+bool CompareScores(unique_ptr<SNode> &i, unique_ptr<SNode> &j); //Returns true is the score of I is smaller than the score of J.
+
+//Returns true if the score of I is larger than the score of J.
+//Used with push_heap and pop_heap, so that the node with the smallest score is kept at the front of the open list.
+bool HeapCompareScores(const unique_ptr<SNode> &i, const unique_ptr<SNode> &j);
+
+//The cost of following the path: The terrain cost of every node on it except the first, scaled for diagonal moves if the movement allows them.
+//Returns INVALID_PATH_COST if two nodes next to each other on the path aren't one move apart under the movement rules.
+const int INVALID_PATH_COST = -1;
+int CalculatePathCost(const TerrainMap& terrain, NodeList& path, const SMovementRules& movement = SMovementRules());
+
+
+//Tests that the path runs from start to goal through squares that aren't walls, making only the moves the movement allows.
+bool IsPathValid(const TerrainMap& terrain, NodeList& path, SIntVector start, SIntVector goal, const SMovementRules& movement = SMovementRules());
+
+//Returns false if the map's component index shows that none of the nodes on the open list can reach the goal.
+//Checked on the first step of a search, so a goal that can't be reached is rejected without searching.
+bool CanReachGoal(const TerrainMap& terrain, NodeList& openList, const SNode* goal, const SMovementRules& movement = SMovementRules());
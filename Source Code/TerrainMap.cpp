@@ -0,0 +1,152 @@
+//Leo Croft
+
+// TerrainMap.cpp
+// ==============
+//
+// Implementation of the flat terrain grid
+//
+
+#include "TerrainMap.h" // Declaration of this class
+#include <atomic>
+
+static atomic<unsigned int> gNextMapId(1);
+
+//Returns an id that hasn't been used by any other map.
+unsigned int CTerrainMap::NewId()
+{
+	return gNextMapId++;
+}
+
+//Copying or moving a map into another counts as changing the terrain of the destination.
+CTerrainMap::CTerrainMap(const CTerrainMap& other) :
+	mCells(other.mCells), mWidth(other.mWidth), mHeight(other.mHeight), mStride(other.mStride), mId(NewId()),
+	mpComponents(other.mpComponents ? new CComponentIndex(*other.mpComponents) : nullptr)
+{
+}
+
+CTerrainMap::CTerrainMap(CTerrainMap&& other) :
+	mCells(move(other.mCells)), mWidth(other.mWidth), mHeight(other.mHeight), mStride(other.mStride), mId(NewId()),
+	mpComponents(move(other.mpComponents))
+{
+	other.Resize(0, 0);
+}
+
+CTerrainMap& CTerrainMap::operator=(const CTerrainMap& other)
+{
+	if (this != &other)
+	{
+		mCells = other.mCells;
+		mWidth = other.mWidth;
+		mHeight = other.mHeight;
+		mStride = other.mStride;
+		mpComponents.reset(other.mpComponents ? new CComponentIndex(*other.mpComponents) : nullptr);
+		mVersion++;
+	}
+	return *this;
+}
+
+CTerrainMap& CTerrainMap::operator=(CTerrainMap&& other)
+{
+	if (this != &other)
+	{
+		mCells = move(other.mCells);
+		mWidth = other.mWidth;
+		mHeight = other.mHeight;
+		mStride = other.mStride;
+		mpComponents = move(other.mpComponents);
+		mVersion++;
+		other.Resize(0, 0);
+	}
+	return *this;
+}
+
+//Changes the size of the map. Every square on the map is set to fill, and the border is set to walls.
+void CTerrainMap::Resize(int width, int height, ENodeType fill)
+{
+	mWidth = width;
+	mHeight = height;
+	mStride = width + 2;
+	mCells.assign(mStride * (height + 2), uint8_t(ENodeType::wall));
+	mVersion++;
+	mpComponents.reset();
+
+	for (int y = 0; y < mHeight; y++)
+	{
+		for (int x = 0; x < mWidth; x++)
+		{
+			mCells[Index(x, y)] = uint8_t(fill);
+		}
+	}
+}
+
+//A hash of the size and terrain of the map (64 bit FNV-1a).
+uint64_t CTerrainMap::ContentHash() const
+{
+	const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	const uint64_t FNV_PRIME = 1099511628211ull;
+
+	uint64_t hash = FNV_OFFSET_BASIS;
+	int header[2] = { mWidth, mHeight };
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(header);
+	for (int i = 0; i < int(sizeof(header)); i++)
+	{
+		hash = (hash ^ bytes[i]) * FNV_PRIME;
+	}
+	for (auto it = mCells.begin(); it != mCells.end(); it++)
+	{
+		hash = (hash ^ *it) * FNV_PRIME;
+	}
+	return hash;
+}
+
+//Labels the areas of the map, and keeps the labels up to date from now on.
+void CTerrainMap::BuildComponentIndex()
+{
+	if (!mpComponents)
+	{
+		mpComponents.reset(new CComponentIndex);
+	}
+	mpComponents->Build(*this);
+}
+
+//Keeps the component index up to date when a square changes between a wall and a square that can be walked on.
+void CTerrainMap::UpdateComponents(int index, bool isWall)
+{
+	if (isWall)
+	{
+		mpComponents->WallAdded(*this, index);
+	}
+	else
+	{
+		mpComponents->WallRemoved(*this, index);
+	}
+}
+
+//Returns false if there is certainly no path between the squares. Without a component index this is always true.
+bool CTerrainMap::CanReach(int startIndex, int goalIndex) const
+{
+	if (!mpComponents || startIndex == goalIndex)
+	{
+		return true;
+	}
+
+	int goalLabel = mpComponents->GetLabel(goalIndex);
+	if (goalLabel == 0)
+	{
+		return false;
+	}
+
+	//The searches can leave a start placed on a wall, so a start on a wall can reach the areas next to it.
+	if (mCells[startIndex] == ENodeType::wall)
+	{
+		for (int direction = ECompass::North; direction <= ECompass::West; direction++)
+		{
+			if (mpComponents->GetLabel(startIndex + Offset(ECompass(direction))) == goalLabel)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	return mpComponents->GetLabel(startIndex) == goalLabel;
+}
@@ -0,0 +1,162 @@
+//Leo Croft
+
+// TerrainMap.h
+// ============
+//
+// Flat grid of terrain used by the searches and the map handler
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include "ComponentIndex.h" // Areas of the map that can reach each other
+#include <cstdint>
+
+// Maps of any size are stored in a single allocation, one byte per square, row by row.
+// A border of walls one square wide surrounds the map, so a search can look at the neighbours of any square on the map
+// without checking the bounds first; The border squares are never walkable.
+// Squares can be addressed by coordinates, or by index for stride arithmetic; The neighbour to the north of index i is i + GetStride().
+// Every map has an id that no other map shares, and a version that changes whenever the terrain does. Together they identify the
+// contents of the map, so data worked out from a map (such as cached paths) can tell when it is out of date.
+// Once BuildComponentIndex has been called the map keeps track of which squares can reach each other as walls are added and removed,
+// so searches can reject a goal that can't be reached without searching. Resizing the map discards the index.
+class CTerrainMap
+{
+private:
+	vector<uint8_t> mCells; //Includes the border.
+	int mWidth = 0; //Size of the map, not including the border.
+	int mHeight = 0;
+	int mStride = 2; //Number of cells in each row, including the border.
+	unsigned int mId; //Unique to this map. Copies are given a new id, as they can be changed separately.
+	unsigned int mVersion = 0; //Incremented by every change to the terrain.
+	unique_ptr<CComponentIndex> mpComponents; //Null until BuildComponentIndex is called.
+
+	//Returns an id that hasn't been used by any other map.
+	static unsigned int NewId();
+
+	//Keeps the component index up to date when a square changes between a wall and a square that can be walked on.
+	void UpdateComponents(int index, bool isWall);
+
+public:
+	CTerrainMap() : mId(NewId()) {}
+	CTerrainMap(int width, int height, ENodeType fill = ENodeType::clear) : mId(NewId())
+	{
+		Resize(width, height, fill);
+	}
+
+	//Copying or moving a map into another counts as changing the terrain of the destination.
+	CTerrainMap(const CTerrainMap& other);
+	CTerrainMap(CTerrainMap&& other);
+	CTerrainMap& operator=(const CTerrainMap& other);
+	CTerrainMap& operator=(CTerrainMap&& other);
+
+	//Changes the size of the map. Every square on the map is set to fill, and the border is set to walls.
+	void Resize(int width, int height, ENodeType fill = ENodeType::clear);
+
+	int GetWidth() const
+	{
+		return mWidth;
+	}
+	int GetHeight() const
+	{
+		return mHeight;
+	}
+	int GetStride() const
+	{
+		return mStride;
+	}
+	unsigned int GetId() const
+	{
+		return mId;
+	}
+	unsigned int GetVersion() const
+	{
+		return mVersion;
+	}
+	bool Empty() const
+	{
+		return mWidth == 0 || mHeight == 0;
+	}
+
+	//A hash of the size and terrain of the map. Unlike the id and version, it is the same for maps with the same contents,
+	//so data saved to disk for a map can tell if it still matches when the map is loaded again.
+	uint64_t ContentHash() const;
+
+	//The number of cells including the border. Per-cell data kept by the searches should be this size so it can share indexes with the map.
+	int Size() const
+	{
+		return mCells.size();
+	}
+
+	//Tests if the coordinates are on the map (not on the border or outside it).
+	bool InBounds(int x, int y) const
+	{
+		return x >= 0 && y >= 0 && x < mWidth && y < mHeight;
+	}
+
+	//Convert between coordinates and index.
+	int Index(int x, int y) const
+	{
+		return (y + 1) * mStride + (x + 1);
+	}
+	int IndexToX(int index) const
+	{
+		return (index % mStride) - 1;
+	}
+	int IndexToY(int index) const
+	{
+		return (index / mStride) - 1;
+	}
+
+	//The difference in index between a square and its neighbour in the given direction.
+	int Offset(ECompass direction) const
+	{
+		switch (direction)
+		{
+		case ECompass::North: return mStride;
+		case ECompass::East: return 1;
+		case ECompass::South: return -mStride;
+		default: return -1;
+		}
+	}
+
+	//Terrain at the given coordinates. The coordinates may be one square outside the map, which is always a wall.
+	ENodeType Get(int x, int y) const
+	{
+		return ENodeType(mCells[Index(x, y)]);
+	}
+
+	//Terrain at the given index.
+	ENodeType operator[](int index) const
+	{
+		return ENodeType(mCells[index]);
+	}
+
+	//Changes the terrain of a square on the map.
+	void Set(int x, int y, ENodeType type)
+	{
+		int index = Index(x, y);
+		bool wasWall = (mCells[index] == ENodeType::wall);
+		mCells[index] = uint8_t(type);
+		mVersion++;
+		if (mpComponents && wasWall != (type == ENodeType::wall))
+		{
+			UpdateComponents(index, !wasWall);
+		}
+	}
+
+	//Labels the areas of the map, and keeps the labels up to date from now on. Call once the map has been filled in, as keeping the
+	//labels up to date while a whole map is being set square by square is slower than building them at the end.
+	void BuildComponentIndex();
+
+	bool HasComponentIndex() const
+	{
+		return mpComponents != nullptr;
+	}
+
+	//Returns false if there is certainly no path between the squares. Without a component index this is always true.
+	bool CanReach(int startIndex, int goalIndex) const;
+};
+
+// Maps of any size are implemented as a flat grid
+using TerrainMap = CTerrainMap;
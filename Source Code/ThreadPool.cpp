@@ -0,0 +1,109 @@
+//Leo Croft
+
+// ThreadPool.cpp
+// ==============
+//
+// Implementation of the work stealing thread pool
+//
+
+#include "ThreadPool.h" // Declaration of this class
+
+//Starts the worker threads. 0 uses one thread per hardware thread.
+CThreadPool::CThreadPool(int numThreads) : mNextQueue(0), mQueued(0)
+{
+	if (numThreads <= 0)
+	{
+		numThreads = max(1u, thread::hardware_concurrency());
+	}
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		mQueues.push_back(unique_ptr<SWorkerQueue>(new SWorkerQueue));
+	}
+	for (int i = 0; i < numThreads; i++)
+	{
+		mThreads.push_back(thread(&CThreadPool::WorkerLoop, this, i));
+	}
+}
+
+//Finishes the tasks already submitted, then stops the workers.
+CThreadPool::~CThreadPool()
+{
+	{
+		lock_guard<mutex> lock(mWakeLock);
+		mStopping = true;
+	}
+	mWake.notify_all();
+
+	for (auto it = mThreads.begin(); it != mThreads.end(); it++)
+	{
+		(*it).join();
+	}
+}
+
+//Queues the task to be run by one of the workers.
+void CThreadPool::Submit(PoolTask task)
+{
+	SWorkerQueue& queue = *mQueues[mNextQueue++ % mQueues.size()];
+	{
+		lock_guard<mutex> lock(queue.mLock);
+		queue.mTasks.push_back(move(task));
+	}
+
+	//Counted under the wake lock, so a worker can't decide to sleep between the task being queued and the notify.
+	{
+		lock_guard<mutex> lock(mWakeLock);
+		mQueued++;
+	}
+	mWake.notify_one();
+}
+
+//Takes a task from the worker's own queue, or steals one from another. Returns false if every queue is empty.
+bool CThreadPool::TakeTask(int worker, PoolTask& task)
+{
+	for (int i = 0; i < int(mQueues.size()); i++)
+	{
+		SWorkerQueue& queue = *mQueues[(worker + i) % mQueues.size()];
+		lock_guard<mutex> lock(queue.mLock);
+		if (queue.mTasks.empty())
+		{
+			continue;
+		}
+
+		//The newest task from its own queue (most likely to still be in the cache), or the oldest task from another worker's.
+		if (i == 0)
+		{
+			task = move(queue.mTasks.back());
+			queue.mTasks.pop_back();
+		}
+		else
+		{
+			task = move(queue.mTasks.front());
+			queue.mTasks.pop_front();
+		}
+		mQueued--;
+		return true;
+	}
+	return false;
+}
+
+//The loop run by each worker thread.
+void CThreadPool::WorkerLoop(int worker)
+{
+	while (true)
+	{
+		PoolTask task;
+		if (TakeTask(worker, task))
+		{
+			task(worker);
+			continue;
+		}
+
+		unique_lock<mutex> lock(mWakeLock);
+		mWake.wait(lock, [this] { return mStopping || mQueued > 0; });
+		if (mStopping && mQueued == 0)
+		{
+			return;
+		}
+	}
+}
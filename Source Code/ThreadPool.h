@@ -0,0 +1,63 @@
+//Leo Croft
+
+// ThreadPool.h
+// ============
+//
+// Work stealing thread pool used to run many searches at once
+//
+
+#pragma once
+
+#include "Definitions.h" // Type definitions
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+//A task is given the index of the worker running it, so it can use scratch data kept for that worker.
+using PoolTask = function<void(int worker)>;
+
+// Each worker has its own queue of tasks. Submitted tasks are spread over the queues in turn.
+// A worker takes tasks from the back of its own queue, and when that is empty it steals from the front of the others,
+// so the work stays balanced when some tasks take much longer than others.
+class CThreadPool
+{
+private:
+	//The tasks waiting for one worker. Locked separately so workers rarely wait for each other.
+	struct SWorkerQueue
+	{
+		mutex mLock;
+		deque<PoolTask> mTasks;
+	};
+
+	vector<thread> mThreads;
+	vector<unique_ptr<SWorkerQueue>> mQueues;
+	atomic<int> mNextQueue; //The queue the next submitted task goes to.
+
+	mutex mWakeLock; //Guards sleeping and waking of idle workers.
+	condition_variable mWake;
+	atomic<int> mQueued; //The number of tasks waiting in all of the queues.
+	bool mStopping = false;
+
+	//Takes a task from the worker's own queue, or steals one from another. Returns false if every queue is empty.
+	bool TakeTask(int worker, PoolTask& task);
+
+	//The loop run by each worker thread.
+	void WorkerLoop(int worker);
+
+public:
+	//Starts the worker threads. 0 uses one thread per hardware thread.
+	CThreadPool(int numThreads = 0);
+
+	//Finishes the tasks already submitted, then stops the workers.
+	~CThreadPool();
+
+	int GetNumThreads() const
+	{
+		return mThreads.size();
+	}
+
+	//Queues the task to be run by one of the workers.
+	void Submit(PoolTask task);
+};